@@ -1,914 +1,5053 @@
-/*
- ============================================================================
-
- ██████╗██████╗  ██████╗██╗  ██╗ █████╗
-██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
-██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
-██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
-╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
- ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
-
-	Author      : clbrz
-	Version     : v1.3
-
-	This is free and unencumbered software released into the public domain.
-
-    Anyone is free to copy, modify, publish, use, compile, sell, or
-    distribute this software, either in source code form or as a compiled
-    binary, for any purpose, commercial or non-commercial, and by any
-    means.
-
-    In jurisdictions that recognize copyright laws, the author or authors
-    of this software dedicate any and all copyright interest in the
-    software to the public domain. We make this dedication for the benefit
-    of the public at large and to the detriment of our heirs and
-    successors. We intend this dedication to be an overt act of
-    relinquishment in perpetuity of all present and future rights to this
-    software under copyright law.
-
-    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
-    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
-    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
-    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
-    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
-    OTHER DEALINGS IN THE SOFTWARE.
-
-    For more information, please refer to <http://unlicense.org/>
-    
-	Description : We wanted a self-understood, preferably self-implemented crc code, that we can use freely.
-				 After a lot of hand-wringing and hair pulling, we finally understood the general
-				 class of CRC algorithms for various widths, and the implementation level tricks as well.
-				 REFERENCES:
-				 >> theory, background:
-					 http://www.zlib.net/crc_v3.txt (Ross Williams)
-				 >> practical, implementation oriented:
-					 http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html (Bastian Molkenthin)
-					 check out the references section specially.
-				 >> handbook/reference for current CRC algos:
-					 http://reveng.sourceforge.net/crc-catalogue/ (Greg Cook)
-				 >> some more explanations:
-					 http://www.alterawiki.com/wiki/Practical_CRC_Usage
-				 Thanks to these guys, I finally have a working and clearly understood crc implementation.
-				 the goal is to target any crc-8/crc-16/crc-32 algorithms out there, leaving out the exotic crc widths (12/24/31...)
-				 and to ensure that all the common options can be changed on the go, to keep it flexible.
-				 this is all public domain code.
-
-	credits: http://patorjk.com/software/taag/#p=display&h=0&v=1&f=ANSI%20Shadow&t=crcx8
-
-	usage :
-	(1) decide if you want to use TABLE -> yes if you don't know, leave the CLBRZCRCX8_USE_TABLE_FOR_CRC defined
-	(3) create the CRCTypeDescriptor_t instance, with the parameters: name width poly init xorout refin refout check_value
-	name is an optional string to describe this crc configuration
-	check_value is optional, and is the result of the CRC algo running over the string: "123456789\0"
-	if valid check_value is passed in, then crc_self_test() can be used to check if this algo is ok.
-	(2) call init_crc() with the CRCTypeDescriptor_t instance address.
-	(3) call calculate_crc_chunk() as many times on the data stream, each call returns an "intermediate crc" if you would like to use this
-	(4) call finalize_crc(), returns the calculated crc.
-
-	To repeat crc on another set of data with the same crc config:
-	(1) call reset_crc()
-	(2) follow steps (3) and (4) as above
-
- ============================================================================
- */
-
-
-#include "clbrz_crcx8.h"
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <stdint.h>
-#include <string.h>
-
-
-
-
-#ifdef CLBRZCRCX8_USE_TABLE_FOR_CRC
-
-#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-
-uint32_t clbrzcrcx8_crc_table [256] = {0};
-
-#else
-
-uint32_t clbrzcrcx8_crc_table[256] =
-{
-0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9, 0x130476dc, 0x17c56b6b, 0x1a864db2, 0x1e475005,
-0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61, 0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd,
-0x4c11db70, 0x48d0c6c7, 0x4593e01e, 0x4152fda9, 0x5f15adac, 0x5bd4b01b, 0x569796c2, 0x52568b75,
-0x6a1936c8, 0x6ed82b7f, 0x639b0da6, 0x675a1011, 0x791d4014, 0x7ddc5da3, 0x709f7b7a, 0x745e66cd,
-0x9823b6e0, 0x9ce2ab57, 0x91a18d8e, 0x95609039, 0x8b27c03c, 0x8fe6dd8b, 0x82a5fb52, 0x8664e6e5,
-0xbe2b5b58, 0xbaea46ef, 0xb7a96036, 0xb3687d81, 0xad2f2d84, 0xa9ee3033, 0xa4ad16ea, 0xa06c0b5d,
-0xd4326d90, 0xd0f37027, 0xddb056fe, 0xd9714b49, 0xc7361b4c, 0xc3f706fb, 0xceb42022, 0xca753d95,
-0xf23a8028, 0xf6fb9d9f, 0xfbb8bb46, 0xff79a6f1, 0xe13ef6f4, 0xe5ffeb43, 0xe8bccd9a, 0xec7dd02d,
-0x34867077, 0x30476dc0, 0x3d044b19, 0x39c556ae, 0x278206ab, 0x23431b1c, 0x2e003dc5, 0x2ac12072,
-0x128e9dcf, 0x164f8078, 0x1b0ca6a1, 0x1fcdbb16, 0x018aeb13, 0x054bf6a4, 0x0808d07d, 0x0cc9cdca,
-0x7897ab07, 0x7c56b6b0, 0x71159069, 0x75d48dde, 0x6b93dddb, 0x6f52c06c, 0x6211e6b5, 0x66d0fb02,
-0x5e9f46bf, 0x5a5e5b08, 0x571d7dd1, 0x53dc6066, 0x4d9b3063, 0x495a2dd4, 0x44190b0d, 0x40d816ba,
-0xaca5c697, 0xa864db20, 0xa527fdf9, 0xa1e6e04e, 0xbfa1b04b, 0xbb60adfc, 0xb6238b25, 0xb2e29692,
-0x8aad2b2f, 0x8e6c3698, 0x832f1041, 0x87ee0df6, 0x99a95df3, 0x9d684044, 0x902b669d, 0x94ea7b2a,
-0xe0b41de7, 0xe4750050, 0xe9362689, 0xedf73b3e, 0xf3b06b3b, 0xf771768c, 0xfa325055, 0xfef34de2,
-0xc6bcf05f, 0xc27dede8, 0xcf3ecb31, 0xcbffd686, 0xd5b88683, 0xd1799b34, 0xdc3abded, 0xd8fba05a,
-0x690ce0ee, 0x6dcdfd59, 0x608edb80, 0x644fc637, 0x7a089632, 0x7ec98b85, 0x738aad5c, 0x774bb0eb,
-0x4f040d56, 0x4bc510e1, 0x46863638, 0x42472b8f, 0x5c007b8a, 0x58c1663d, 0x558240e4, 0x51435d53,
-0x251d3b9e, 0x21dc2629, 0x2c9f00f0, 0x285e1d47, 0x36194d42, 0x32d850f5, 0x3f9b762c, 0x3b5a6b9b,
-0x0315d626, 0x07d4cb91, 0x0a97ed48, 0x0e56f0ff, 0x1011a0fa, 0x14d0bd4d, 0x19939b94, 0x1d528623,
-0xf12f560e, 0xf5ee4bb9, 0xf8ad6d60, 0xfc6c70d7, 0xe22b20d2, 0xe6ea3d65, 0xeba91bbc, 0xef68060b,
-0xd727bbb6, 0xd3e6a601, 0xdea580d8, 0xda649d6f, 0xc423cd6a, 0xc0e2d0dd, 0xcda1f604, 0xc960ebb3,
-0xbd3e8d7e, 0xb9ff90c9, 0xb4bcb610, 0xb07daba7, 0xae3afba2, 0xaafbe615, 0xa7b8c0cc, 0xa379dd7b,
-0x9b3660c6, 0x9ff77d71, 0x92b45ba8, 0x9675461f, 0x8832161a, 0x8cf30bad, 0x81b02d74, 0x857130c3,
-0x5d8a9099, 0x594b8d2e, 0x5408abf7, 0x50c9b640, 0x4e8ee645, 0x4a4ffbf2, 0x470cdd2b, 0x43cdc09c,
-0x7b827d21, 0x7f436096, 0x7200464f, 0x76c15bf8, 0x68860bfd, 0x6c47164a, 0x61043093, 0x65c52d24,
-0x119b4be9, 0x155a565e, 0x18197087, 0x1cd86d30, 0x029f3d35, 0x065e2082, 0x0b1d065b, 0x0fdc1bec,
-0x3793a651, 0x3352bbe6, 0x3e119d3f, 0x3ad08088, 0x2497d08d, 0x2056cd3a, 0x2d15ebe3, 0x29d4f654,
-0xc5a92679, 0xc1683bce, 0xcc2b1d17, 0xc8ea00a0, 0xd6ad50a5, 0xd26c4d12, 0xdf2f6bcb, 0xdbee767c,
-0xe3a1cbc1, 0xe760d676, 0xea23f0af, 0xeee2ed18, 0xf0a5bd1d, 0xf464a0aa, 0xf9278673, 0xfde69bc4,
-0x89b8fd09, 0x8d79e0be, 0x803ac667, 0x84fbdbd0, 0x9abc8bd5, 0x9e7d9662, 0x933eb0bb, 0x97ffad0c,
-0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668, 0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4,
-};
-
-
-#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-
-#endif // #ifdef CLBRZCRCX8_USE_TABLE_FOR_CRC
-
-
-#define TOPBIT(width)	 		(1UL << (width-1UL))
-
-// this portable mask stuff was stolen from: http://www.zlib.net/crc_v3.txt, Ross Williams, avoid for e.g << 32 on a 32-bit machine !!
-// the original, naive stuff is commented below, followed by the magic way to do it right.
-//#define CRC_MASK(width)			((1 << (width)) - 1)
-#define CRC_MASK(width)			((((1UL<<(width-1))-1UL)<<1UL)|1UL)
-
-#define BITMASK(X) 				(1UL << (X))
-
-
-
-// stolen from:  http://www.zlib.net/crc_v3.txt, Ross Williams.
-// Returns the value with the bottom b [0,n] bits reflected.
-// Example: reflect(0x3e23L,3) == 0x3e26
-uint32_t clbrzcrcx8_reflect(uint32_t value, uint8_t num_bits_to_reflect)
-{
-	int bit_index;
-	uint32_t temp_value = value;
-	for (bit_index = 0; bit_index < num_bits_to_reflect; bit_index++)
-	{
-		if (temp_value & (uint32_t)1)
-		{
-			value |=  BITMASK((num_bits_to_reflect-1)-bit_index);
-		}
-		else
-		{
-			value &= ~BITMASK((num_bits_to_reflect-1)-bit_index);
-		}
-
-		temp_value >>= 1;
-	}
-
-	return value;
-}
-
-
-// INTERNAL FUNCTIONS
-#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-void _clbrzcrcx8_generate_crc_table(uint32_t generator_polynomial, uint8_t crc_width)
-{
-	uint16_t byte_value;
-	uint8_t bit_index;
-	uint32_t crc_value;
-
-	// iterate over all byte values 0 - 255
-	for (byte_value = 0; byte_value < 256; byte_value++)
-	{
-		// calculate the CRC-8 value for current byte
-
-		crc_value = byte_value << (crc_width - 8); // move byte into MSB of 32Bit CRC
-
-		for (bit_index = 0; bit_index < 8; bit_index++)
-		{
-			if ((crc_value & TOPBIT(crc_width)) != 0)
-			{
-				crc_value = (crc_value << 1) ^ generator_polynomial;
-			}
-			else
-			{
-				crc_value <<= 1;
-			}
-		}
-		/* store CRC value in lookup table */
-		clbrzcrcx8_crc_table[byte_value] = (crc_value & CRC_MASK(crc_width));
-	}
-}
-#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-
-
-#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-void _clbrzcrcx8_print_crc_table(uint8_t crc_width)
-{
-	uint16_t byte_value;
-
-	printf("clbrzcrcx8_crc_table[256] = \n{\n");
-
-	// iterate over all byte values 0 - 255
-	for (byte_value = 0; byte_value < 256; byte_value+=8)
-	{
-		// 4 bits = 1 hex, use format specifier * for variable based substitution
-		// https://stackoverflow.com/questions/5932214/printf-string-variable-length-item
-		printf("0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x,\n",
-															crc_width/4,clbrzcrcx8_crc_table[byte_value],
-															crc_width/4,clbrzcrcx8_crc_table[byte_value+1],
-															crc_width/4,clbrzcrcx8_crc_table[byte_value+2],
-															crc_width/4,clbrzcrcx8_crc_table[byte_value+3],
-															crc_width/4,clbrzcrcx8_crc_table[byte_value+4],
-															crc_width/4,clbrzcrcx8_crc_table[byte_value+5],
-															crc_width/4,clbrzcrcx8_crc_table[byte_value+6],
-															crc_width/4,clbrzcrcx8_crc_table[byte_value+7]);
-	}
-
-	printf("};\n\n");
-}
-#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-
-
-
-// internal variables to keep track of chunked crc configuration
-// default config - CRC-32 : width=32 poly=0x04c11db7 init=0xffffffff refin=true refout=true xorout=0xffffffff check=0xcbf43926 name="CRC-32"
-
-struct crc_info
-{
-	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
-	uint32_t calculated_crc;
-};
-
-// keep the currently configured crc and its state in memory.
-static
-struct crc_info current_crc_info =
-				{
-					{
-						"default",		// optional here, can be any string
-						32,
-						0x04c11db7,
-						0xffffffff,
-						0xffffffff,
-						1,
-						1,
-						0xcbf43926,		// optional here : check
-						0x00000000,		// optional here : residue
-					},
-					0xffffffff
-				};
-
-
-void clbrzcrcx8_init_crc(CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr)
-{
-	current_crc_info.crc_configuration = (*crc_configuration_ptr);
-
-	current_crc_info.calculated_crc =
-			current_crc_info.crc_configuration.initial_value
-			&
-			CRC_MASK(current_crc_info.crc_configuration.width);
-
-#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-	clbrzcrcx8_generate_crc_table();
-#endif // CLBRZCRCX8_USE_TABLE_FOR_CRC
-}
-
-
-uint32_t clbrzcrcx8_calculate_crc_chunk(uint8_t* byte_data, int32_t data_len)
-{
-	int32_t byte_data_index;
-#ifndef CLBRZCRCX8_USE_TABLE_FOR_CRC
-	int32_t bit_index;
-#endif // #ifdef CLBRZCRCX8_USE_TABLE_FOR_CRC
-
-	// start from previous CRC value
-	uint32_t calculated_crc =
-			current_crc_info.calculated_crc
-			&
-			CRC_MASK(current_crc_info.crc_configuration.width);
-
-	for(byte_data_index = 0; byte_data_index < data_len; byte_data_index++) // for each byte of data:
-	{
-		// xor in the next input byte, **at the MSB**
-		if(current_crc_info.crc_configuration.reflect_input == 1)
-		{
-			calculated_crc ^= clbrzcrcx8_reflect(byte_data[byte_data_index],8) << (current_crc_info.crc_configuration.width-8);
-			calculated_crc = calculated_crc & CRC_MASK(current_crc_info.crc_configuration.width);
-		}
-		else
-		{
-			calculated_crc ^= byte_data[byte_data_index] << (current_crc_info.crc_configuration.width-8);
-			calculated_crc = calculated_crc & CRC_MASK(current_crc_info.crc_configuration.width);
-		}
-
-#ifdef CLBRZCRCX8_USE_TABLE_FOR_CRC
-
-		// http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html
-		// (1)The important point is here that after xoring the current byte into the MSB of the intermediate CRC,
-		// the MSB is the index into the lookup table, so take ONLY MSB for lookup table index... this explains the crc_value >> (WIDTH-8)
-		// used for the lookup table.
-		// (2) now, as we are getting the value corresponding to MSB from the lookup table, drop the MSB from the crc
-		// i.e. shift the crc left, dropping the msb, then XOR this crc/remainder with the lookuptable value.
-		calculated_crc = (calculated_crc << 8) ^ (clbrzcrcx8_crc_table[calculated_crc >> (current_crc_info.crc_configuration.width-8) ]);
-		calculated_crc = calculated_crc & CRC_MASK(current_crc_info.crc_configuration.width);
-
-#else
-
-
-		// calculate crc by iterating over each bit of current byte and applying polynomial.
-		for (bit_index = 0; bit_index < 8; bit_index++)
-		{
-			// if the MSbit is 1, left-shift and apply the polynomial, else just left-shift
-			if ((calculated_crc & TOPBIT(current_crc_info.crc_configuration.width)) != 0)
-			{
-				calculated_crc = ( ( (calculated_crc << 1) ^ current_crc_info.crc_configuration.polynomial ) & CRC_MASK(current_crc_info.crc_configuration.width) );
-			}
-			else
-			{
-				calculated_crc <<= 1;
-			}
-		}
-
-
-#endif // CLBRZCRCX8_USE_TABLE_FOR_CRC
-
-
-		// at this point, we have the calculated crc upto the current byte.
-	}
-	current_crc_info.calculated_crc  =	calculated_crc;
-
-	return current_crc_info.calculated_crc;
-}
-
-
-uint32_t clbrzcrcx8_reset_crc_chunk()
-{
-	current_crc_info.calculated_crc =
-			current_crc_info.crc_configuration.initial_value
-			&
-			CRC_MASK(current_crc_info.crc_configuration.width);
-
-
-	return current_crc_info.calculated_crc;
-}
-
-
-uint32_t clbrzcrcx8_finalize_crc()
-{
-	uint32_t calculated_crc =
-			current_crc_info.calculated_crc
-			&
-			CRC_MASK(current_crc_info.crc_configuration.width);
-
-	// xor with final_xor_value:
-	if(current_crc_info.crc_configuration.reflect_output == 1)
-	{
-		calculated_crc =  clbrzcrcx8_reflect(calculated_crc,current_crc_info.crc_configuration.width) & CRC_MASK(current_crc_info.crc_configuration.width);
-		calculated_crc ^= current_crc_info.crc_configuration.final_xor_value;
-	}
-	else
-	{
-		calculated_crc ^= current_crc_info.crc_configuration.final_xor_value;
-	}
-	current_crc_info.calculated_crc  =	calculated_crc;
-
-	return current_crc_info.calculated_crc;
-}
-
-
-#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-void clbrzcrcx8_generate_crc_table()
-{
-	_clbrzcrcx8_generate_crc_table(current_crc_info.crc_configuration.polynomial,
-						current_crc_info.crc_configuration.width);
-}
-
-void clbrzcrcx8_print_crc_table()
-{
-	_clbrzcrcx8_print_crc_table(current_crc_info.crc_configuration.width);
-}
-#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-
-
-#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
-uint32_t clbrzcrcx8_calculate_self_residue()
-{
-	// WORK IN PROGRESS, does not work as expected with refin=refout=true!
-	uint32_t calculated_crc;
-	//uint32_t residue[3];
-	uint8_t _data [14];
-	uint8_t crc_width_bytes = current_crc_info.crc_configuration.width/8;
-
-	memcpy(_data, (uint8_t*)"123456789", 9);
-	clbrzcrcx8_reset_crc_chunk();
-	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9);
-	calculated_crc = clbrzcrcx8_finalize_crc();
-	clbrzcrcx8_reset_crc_chunk();
-	if(current_crc_info.crc_configuration.reflect_input == 0 &&
-			current_crc_info.crc_configuration.reflect_output == 0 )
-	{
-		//calculated_crc = 0;
-	}
-	memcpy(_data + 9, (uint8_t*)&calculated_crc,  crc_width_bytes);
-	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9 + crc_width_bytes);
-	calculated_crc = clbrzcrcx8_finalize_crc();
-	clbrzcrcx8_reset_crc_chunk();
-
-	printf("residue: 0x%08x\n\n",calculated_crc);
-
-
-
-	memcpy(_data, (uint8_t*)"987654321", 9);
-	clbrzcrcx8_reset_crc_chunk();
-	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9);
-	calculated_crc = clbrzcrcx8_finalize_crc();
-	clbrzcrcx8_reset_crc_chunk();
-	if(current_crc_info.crc_configuration.reflect_input == 0 &&
-			current_crc_info.crc_configuration.reflect_output == 0 )
-	{
-		//calculated_crc = 0;
-	}
-	memcpy(_data + 9, (uint8_t*)&calculated_crc,  crc_width_bytes);
-	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9 + crc_width_bytes);
-	calculated_crc = clbrzcrcx8_finalize_crc();
-	clbrzcrcx8_reset_crc_chunk();
-
-	printf("residue: 0x%08x\n\n",calculated_crc);
-
-
-
-	memcpy(_data, (uint8_t*)"123123123", 9);
-	clbrzcrcx8_reset_crc_chunk();
-	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9);
-	calculated_crc = clbrzcrcx8_finalize_crc();
-	clbrzcrcx8_reset_crc_chunk();
-	if(current_crc_info.crc_configuration.reflect_input == 0 &&
-			current_crc_info.crc_configuration.reflect_output == 0 )
-	{
-		//calculated_crc = 0;
-	}
-	memcpy(_data + 9, (uint8_t*)&calculated_crc,  crc_width_bytes);
-	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9 + crc_width_bytes);
-	calculated_crc = clbrzcrcx8_finalize_crc();
-	clbrzcrcx8_reset_crc_chunk();
-
-	printf("residue: 0x%08x\n\n",calculated_crc);
-
-
-
-	memcpy(_data, (uint8_t*)"123123123123", 12);
-	clbrzcrcx8_reset_crc_chunk();
-	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,12);
-	calculated_crc = clbrzcrcx8_finalize_crc();
-	clbrzcrcx8_reset_crc_chunk();
-	if(current_crc_info.crc_configuration.reflect_input == 0 &&
-			current_crc_info.crc_configuration.reflect_output == 0 )
-	{
-		//calculated_crc = 0;
-	}
-	memcpy(_data + 12, (uint8_t*)&calculated_crc,  crc_width_bytes);
-	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,12 + crc_width_bytes);
-	calculated_crc = clbrzcrcx8_finalize_crc();
-	clbrzcrcx8_reset_crc_chunk();
-
-	printf("residue: 0x%08x\n\n",calculated_crc);
-
-	//NOTE: residue is reflected in our algo compared to reveng catalogue.
-
-	return 0;
-}
-#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
-
-
-#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
-// init_crc() must be called with valid configuration and valid check value before this !
-int clbrzcrcx8_self_test()
-{
-	uint32_t calculated_crc;
-	// assumed that the user has set proper configuration using init_crc, including the check value.
-	// the CRC algorithm is run over the string : "123456789\0" and calculated crc should be the check value.
-	// if not, then the crc implementation has a problem with the particular configuration or the check value is wrong.
-	// this is more of a sanity test to check that the crc works ok, and not meant to be used for anything else.
-	clbrzcrcx8_reset_crc_chunk();
-	calculated_crc = clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = clbrzcrcx8_finalize_crc();
-	clbrzcrcx8_reset_crc_chunk();
-
-	if(calculated_crc != current_crc_info.crc_configuration.check_value)
-	{
-		//printf("\n%-20s : self-test failed.\n", current_crc_info.crc_configuration.crc_algo_name);
-		return 0; // failed self test
-	}
-
-	//printf("\n%-20s : self-test ok.\n", current_crc_info.crc_configuration.crc_algo_name);
-	return 1; // ok
-}
-#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
-
-
-#ifdef CLBRZCRCX8_ENABLE_CRC_TEST
-int clbrzcrcx8_check_crc_8_algo()
-{
-	uint8_t calculated_crc;
-	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
-
-	// CRC-8 : width=8 poly=0x07 init=0x00 refin=false refout=false xorout=0x00 check=0xf4 name="CRC-8"
-	crc_configuration.name = "CRC-8";					// optional
-	crc_configuration.width = 8;
-	crc_configuration.polynomial = 0x07;
-	crc_configuration.initial_value = 0x00;
-	crc_configuration.final_xor_value = 0x00;
-	crc_configuration.reflect_input = 0;
-	crc_configuration.reflect_output = 0;
-	crc_configuration.check_value = 0xf4;						// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x00;							// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-
-	calculated_crc = (uint8_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint8_t)clbrzcrcx8_finalize_crc();
-	//print_crc_table();
-
-	if(0xf4 != calculated_crc)
-	{
-		printf ("CRC-8 reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-8 check passed.\n\n");
-	}
-
-
-	// CRC-8/CDMA2000 : width=8 poly=0x9b init=0xff refin=false refout=false xorout=0x00 check=0xda name="CRC-8/CDMA2000"
-	crc_configuration.name = "CRC-8/CDMA2000";					// optional
-	crc_configuration.width = 8;
-	crc_configuration.polynomial = 0x9b;
-	crc_configuration.initial_value = 0xff;
-	crc_configuration.final_xor_value = 0x00;
-	crc_configuration.reflect_input = 0;
-	crc_configuration.reflect_output = 0;
-	crc_configuration.check_value = 0xda;								// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x00;							// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-	calculated_crc = (uint8_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint8_t)clbrzcrcx8_finalize_crc();
-
-	if(0xda != calculated_crc)
-	{
-		printf ("CRC-8/CDMA2000 reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-8/CDMA2000 check passed.\n\n");
-	}
-
-
-	// CRC-8/ITU : width=8 poly=0x07 init=0x00 refin=false refout=false xorout=0x55 check=0xa1 name="CRC-8/ITU"
-	crc_configuration.name = "CRC-8/ITU";						// optional
-	crc_configuration.width = 8;
-	crc_configuration.polynomial = 0x07;
-	crc_configuration.initial_value = 0x00;
-	crc_configuration.final_xor_value = 0x55;
-	crc_configuration.reflect_input = 0;
-	crc_configuration.reflect_output = 0;
-	crc_configuration.check_value = 0xa1;								// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x00;									// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-	calculated_crc = (uint8_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint8_t)clbrzcrcx8_finalize_crc();
-
-	if(0xa1 != calculated_crc)
-	{
-		printf ("CRC-8/ITU reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-8/ITU check passed.\n\n");
-	}
-
-
-	// CRC-8/DARC : width=8 poly=0x39 init=0x00 refin=true refout=true xorout=0x00 check=0x15 name="CRC-8/DARC"
-	crc_configuration.name = "CRC-8/DARC";						// optional
-	crc_configuration.width = 8;
-	crc_configuration.polynomial = 0x39;
-	crc_configuration.initial_value = 0x00;
-	crc_configuration.final_xor_value = 0x00;
-	crc_configuration.reflect_input = 1;
-	crc_configuration.reflect_output = 1;
-	crc_configuration.check_value = 0x15;								// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x00;							// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-	clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint8_t)clbrzcrcx8_finalize_crc();
-
-	if(0x15 != calculated_crc)
-	{
-		printf ("CRC-8/DARC reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-8/DARC check passed.\n\n");
-	}
-
-
-	return 1; // ok.
-}
-
-
-int clbrzcrcx8_check_crc_16_algo()
-{
-	uint16_t calculated_crc;
-	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
-
-	// CRC-16/AUG-CCITT : width=16 poly=0x1021 init=0x1d0f refin=false refout=false xorout=0x0000 check=0xe5cc name="CRC-16/AUG-CCITT"
-	crc_configuration.name = "CRC-16/AUG-CCITT";			// optional
-	crc_configuration.width = 16;
-	crc_configuration.polynomial = 0x1021;
-	crc_configuration.initial_value = 0x1d0f;
-	crc_configuration.final_xor_value = 0x0000;
-	crc_configuration.reflect_input = 0;
-	crc_configuration.reflect_output = 0;
-	crc_configuration.check_value = 0xe5cc;							// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x0000;								// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-	calculated_crc = (uint16_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint16_t)clbrzcrcx8_finalize_crc();
-	//print_crc_table();
-
-	if(0xe5cc != calculated_crc)
-	{
-		printf ("CRC-16/AUG-CCITT reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-16/AUG-CCITT check passed.\n\n");
-	}
-
-
-	// CRC-16/CCITT-FALSE: width=16 poly=0x1021 init=0xffff refin=false refout=false xorout=0x0000 check=0x29b1 name="CRC-16/CCITT-FALSE"
-	crc_configuration.name = "CRC-16/CCITT-FALSE";			// optional
-	crc_configuration.width = 16;
-	crc_configuration.polynomial = 0x1021;
-	crc_configuration.initial_value = 0xffff;
-	crc_configuration.final_xor_value = 0x0000;
-	crc_configuration.reflect_input = 0;
-	crc_configuration.reflect_output = 0;
-	crc_configuration.check_value = 0x29b1;							// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x0000;								// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-	calculated_crc = (uint16_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint16_t)clbrzcrcx8_finalize_crc();
-
-	if(0x29b1 != calculated_crc)
-	{
-		printf ("CRC-16/CCITT-FALSE reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-16/CCITT-FALSE check passed.\n\n");
-	}
-
-
-	// CRC-16/ARC : width=16 poly=0x8005 init=0x0000 refin=true refout=true xorout=0x0000 check=0xbb3d name="ARC"
-	crc_configuration.name = "CRC-16/ARC";					// optional
-	crc_configuration.width = 16;
-	crc_configuration.polynomial = 0x8005;
-	crc_configuration.initial_value = 0x0000;
-	crc_configuration.final_xor_value = 0x0000;
-	crc_configuration.reflect_input = 1;
-	crc_configuration.reflect_output = 1;
-	crc_configuration.check_value = 0xbb3d;							// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x0000;								// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-	calculated_crc = (uint16_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint16_t)clbrzcrcx8_finalize_crc();
-
-	if(0xbb3d != calculated_crc)
-	{
-		printf ("CRC-16/ARC reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-16/ARC check passed.\n\n");
-	}
-
-
-	return 1; // ok.
-}
-
-
-int clbrzcrcx8_check_crc_32_algo()
-{
-	uint32_t calculated_crc;
-	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
-
-	// CRC-32/BZIP2 : width=32 poly=0x04c11db7 init=0xffffffff refin=false refout=false xorout=0xffffffff check=0xfc891918 name="CRC-32/BZIP2"
-	crc_configuration.name = "CRC-32/BZIP2";					// optional
-	crc_configuration.width = 32;
-	crc_configuration.polynomial = 0x04c11db7;
-	crc_configuration.initial_value = 0xffffffff;
-	crc_configuration.final_xor_value = 0xffffffff;
-	crc_configuration.reflect_input = 0;
-	crc_configuration.reflect_output = 0;
-	crc_configuration.check_value = 0xfc891918;							// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x00000000;								// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-	calculated_crc = (uint32_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint32_t)clbrzcrcx8_finalize_crc();
-
-	if(0xfc891918 != calculated_crc)
-	{
-		printf ("CRC-32/BZIP2 reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-32/BZIP2 check passed.\n\n");
-	}
-
-	// CRC-32 : width=32 poly=0x04c11db7 init=0xffffffff refin=true refout=true xorout=0xffffffff check=0xcbf43926 name="CRC-32"
-	crc_configuration.name = "CRC-32";					// optional
-	crc_configuration.width = 32;
-	crc_configuration.polynomial = 0x04c11db7;
-	crc_configuration.initial_value = 0xffffffff;
-	crc_configuration.final_xor_value = 0xffffffff;
-	crc_configuration.reflect_input = 1;
-	crc_configuration.reflect_output = 1;
-	crc_configuration.check_value = 0xcbf43926;						// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x00000000;							// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-	calculated_crc = (uint32_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint32_t)clbrzcrcx8_finalize_crc();
-	//print_crc_table();
-
-	if(0xcbf43926 != calculated_crc)
-	{
-		printf ("CRC-32 reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-32 check passed.\n\n");
-	}
-
-
-	// CRC-32C : width=32 poly=0x1edc6f41 init=0xffffffff refin=true refout=true xorout=0xffffffff check=0xe3069283 name="CRC-32C"
-	crc_configuration.name = "CRC-32C";					// optional
-	crc_configuration.width = 32;
-	crc_configuration.polynomial = 0x1edc6f41;
-	crc_configuration.initial_value = 0xffffffff;
-	crc_configuration.final_xor_value = 0xffffffff;
-	crc_configuration.reflect_input = 1;
-	crc_configuration.reflect_output = 1;
-	crc_configuration.check_value = 0xe3069283;						// optional, check = CRC of string "123456789\0"
-	crc_configuration.residue = 0x00000000;							// optional, residue = CRC (DATA + CRC)
-	clbrzcrcx8_init_crc(&crc_configuration);
-	calculated_crc = (uint32_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
-	calculated_crc = (uint32_t)clbrzcrcx8_finalize_crc();
-
-	if(0xe3069283 != calculated_crc)
-	{
-		printf ("CRC-32C reference check failed!\n\n");
-		return -1;
-	}
-	else
-	{
-		printf ("CRC-32C check passed.\n\n");
-	}
-
-
-	return 1; // ok.
-}
-
-
-int clbrzcrcx8_test()
-{
-	puts("\ncrickey! test crc algo for 8,16,32 bit crcs >>\n"); // prints crickey!
-
-
-	// self-check:
-	printf("\n---------------------------------------\n");
-	if( clbrzcrcx8_check_crc_8_algo() == 1)
-	{
-		printf(">> CRC-8 ok. <<\n");
-	}
-	else
-	{
-		printf(">> CRC-8 test failed. <<\n");
-		return -1;
-	}
-	printf("---------------------------------------\n\n");
-
-	printf("\n---------------------------------------\n");
-	if( clbrzcrcx8_check_crc_16_algo() == 1)
-	{
-		printf(">> CRC-16 ok. <<\n");
-	}
-	else
-	{
-		printf(">> CRC-16 test failed. <<\n");
-		return -1;
-	}
-	printf("---------------------------------------\n\n");
-
-	printf("\n---------------------------------------\n");
-	if( clbrzcrcx8_check_crc_32_algo() == 1)
-	{
-		printf(">> CRC-32 ok. <<\n");
-	}
-	else
-	{
-		printf(">> CRC-32 test failed. <<\n");
-		return -1;
-	}
-	printf("---------------------------------------\n\n");
-
-
-	return 1;
-}
-#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_TEST
-
-// TODO add further configurations from <reveng>
-CLBRZCRCx8_CRCTypeDescriptor_t clbrzcrcx8_crc_algo_list[] =
-{
-//		  name						width	poly		init		xor			refin	refout	check
-		{ "CRC-8",					8, 		0x00000007, 0x00000000, 0x00000000, 0, 		0, 		0x000000f4 },
-		{ "CRC-8/AUTOSAR",			8, 		0x0000002f, 0x000000ff, 0x000000ff, 0, 		0, 		0x000000df },
-		{ "CRC-8/BLUETOOTH",		8, 		0x000000a7, 0x00000000, 0x00000000, 1, 		1, 		0x00000026 },
-		{ "CRC-16/CCITT",	  		16, 	0x00001021, 0x00000000, 0x00000000, 1, 		1, 		0x00002189 },
-		{ "CRC-16/ARC",	  			16,		0x00008005, 0x00000000, 0x00000000, 1, 		1, 		0x0000bb3d },
-		{ "CRC-24/OPENPGP",	  		24,		0x00864cfb, 0x00b704ce, 0x00000000, 0, 		0, 		0x0021cf02 },
-		{ "CRC-24/BLE",	  			24,		0x0000065b, 0x00555555, 0x00000000, 1, 		1, 		0x00c25a56 },
-		{ "CRC-24/FLEXRAY-B",	  	24,		0x005d6dcb, 0x00abcdef, 0x00000000, 0, 		0, 		0x001f23b8 },
-		{ "CRC-32",	  				32,		0x04c11db7, 0xffffffff, 0xffffffff, 1, 		1, 		0xcbf43926 },
-		{ "CRC-32C",	  			32,		0x1edc6f41, 0xffffffff, 0xffffffff, 1, 		1, 		0xe3069283 },
-		{ "CRC-32/AUTOSAR",	  		32,		0xf4acfb13, 0xffffffff, 0xffffffff, 1, 		1, 		0x1697d06a },
-		{ "CRC-32/BZIP2",	  		32,		0x04c11db7, 0xffffffff, 0xffffffff, 0, 		0, 		0xfc891918 },
-
-};
-
-int clbrzcrcx8_crc_algo_list_size = sizeof(clbrzcrcx8_crc_algo_list)/sizeof(CLBRZCRCx8_CRCTypeDescriptor_t);
-
-
-#ifdef CLBRZCRCX8_ENABLE_CRC_TEST
-
-int main()
-{
-	clbrzcrcx8_test();
-
-	int i = 0;
-
-	printf("\n%-5s \t %-16s \t %-5s \t %-10s \t %-10s \t %-10s \t %-6s \t %-6s \t %-10s \n\n",
-			"index",
-			"name",
-			"width",
-			"poly",
-			"init",
-			"xor",
-			"refin",
-			"refout",
-			"check");
-	for (i = 0; i < clbrzcrcx8_crc_algo_list_size; i++)
-	{
-		printf("%-5d \t %-16s \t %-5d \t 0x%08x \t 0x%08x \t 0x%08x \t %-6d \t %-6d \t 0x%08x\n",
-				i,
-				clbrzcrcx8_crc_algo_list[i].name,
-				clbrzcrcx8_crc_algo_list[i].width,
-				clbrzcrcx8_crc_algo_list[i].polynomial,
-				clbrzcrcx8_crc_algo_list[i].initial_value,
-				clbrzcrcx8_crc_algo_list[i].final_xor_value,
-				clbrzcrcx8_crc_algo_list[i].reflect_input,
-				clbrzcrcx8_crc_algo_list[i].reflect_output,
-				clbrzcrcx8_crc_algo_list[i].check_value);
-
-
-		// enable the below code to test ALL the CRC algorithms added in the list!
-#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
-		clbrzcrcx8_init_crc(&clbrzcrcx8_crc_algo_list[i]);
-		if(clbrzcrcx8_self_test() == 1)
-		{
-			printf("self-check : PASS\n\n");
-		}
-		else
-		{
-			printf("self-check : FAIL\n\n");
-		}
-#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
-
-
-#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
-		clbrzcrcx8_calculate_self_residue();
-#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
-	}
-
-	return 0;
-}
-
-#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_TEST
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+	This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+    
+	Description : We wanted a self-understood, preferably self-implemented crc code, that we can use freely.
+				 After a lot of hand-wringing and hair pulling, we finally understood the general
+				 class of CRC algorithms for various widths, and the implementation level tricks as well.
+				 REFERENCES:
+				 >> theory, background:
+					 http://www.zlib.net/crc_v3.txt (Ross Williams)
+				 >> practical, implementation oriented:
+					 http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html (Bastian Molkenthin)
+					 check out the references section specially.
+				 >> handbook/reference for current CRC algos:
+					 http://reveng.sourceforge.net/crc-catalogue/ (Greg Cook)
+				 >> some more explanations:
+					 http://www.alterawiki.com/wiki/Practical_CRC_Usage
+				 Thanks to these guys, I finally have a working and clearly understood crc implementation.
+				 the goal is to target any crc-8/crc-16/crc-32 algorithms out there, leaving out the exotic crc widths (12/24/31...)
+				 and to ensure that all the common options can be changed on the go, to keep it flexible.
+				 this is all public domain code.
+
+	credits: http://patorjk.com/software/taag/#p=display&h=0&v=1&f=ANSI%20Shadow&t=crcx8
+
+	usage :
+	(1) decide if you want to use TABLE -> yes if you don't know, leave the CLBRZCRCX8_USE_TABLE_FOR_CRC defined
+	(3) create the CRCTypeDescriptor_t instance, with the parameters: name width poly init xorout refin refout check_value
+	name is an optional string to describe this crc configuration
+	check_value is optional, and is the result of the CRC algo running over the string: "123456789\0"
+	if valid check_value is passed in, then crc_self_test() can be used to check if this algo is ok.
+	(2) call init_crc() with the CRCTypeDescriptor_t instance address.
+	(3) call calculate_crc_chunk() as many times on the data stream, each call returns an "intermediate crc" if you would like to use this
+	(4) call finalize_crc(), returns the calculated crc.
+
+	To repeat crc on another set of data with the same crc config:
+	(1) call reset_crc()
+	(2) follow steps (3) and (4) as above
+
+ ============================================================================
+ */
+
+
+// the parallel crc pins its workers to NUMA nodes : pthread_setaffinity_np() and the cpu_set_t macros are GNU extensions.
+#if defined(CLBRZCRCX8_ENABLE_PARALLEL) && defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+// the scrub rate limit and the calibration use POSIX clock_gettime()/nanosleep(), make sure they are declared in strict ISO C builds too.
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "clbrz_crcx8.h"
+#include "clbrz_crcx8_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+
+// table sets : slicing/reflected tables per (poly, width, refin), either generated at runtime or at build time.
+#if defined(CLBRZCRCX8_USE_TABLE_FOR_CRC) && (defined(CLBRZCRCX8_ENABLE_TABLE_GENERATION) || defined(CLBRZCRCX8_USE_GENERATED_TABLES))
+#define CLBRZCRCX8_HAVE_TABLE_SETS
+#endif
+
+// the calibration picks between the table set engines and the bitwise one, without table sets there is nothing to pick.
+#if defined(CLBRZCRCX8_ENABLE_CALIBRATION) && !defined(CLBRZCRCX8_HAVE_TABLE_SETS)
+#error "CLBRZCRCX8_ENABLE_CALIBRATION needs table sets : CLBRZCRCX8_USE_GENERATED_TABLES or CLBRZCRCX8_ENABLE_TABLE_GENERATION"
+#endif
+
+// the single global table : runtime generated, or the fixed one, not needed if only build time tables are used.
+#if defined(CLBRZCRCX8_USE_TABLE_FOR_CRC) && (defined(CLBRZCRCX8_ENABLE_TABLE_GENERATION) || !defined(CLBRZCRCX8_USE_GENERATED_TABLES))
+#define CLBRZCRCX8_HAVE_GLOBAL_TABLE
+#endif
+
+// x86 SIMD engines (batch, bulk reflect) : compiled in with gcc/clang target attributes, picked at runtime.
+#if defined(CLBRZCRCX8_USE_SIMD_FOR_CRC) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CLBRZCRCX8_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// scalar engines built once per x86-64 level, resolved once at load time through an ifunc : needs gcc/clang on an ELF target.
+// the table loops gain movbe/shrx/andn (v3), the bitwise loop gets vectorized on the wider levels.
+#if defined(CLBRZCRCX8_USE_MULTIVERSIONING) && defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__) &&	\
+	(!defined(__clang__) || (__clang_major__ >= 14))
+#define CLBRZCRCX8_MULTIVERSION	__attribute__((target_clones("default", "arch=x86-64-v2", "arch=x86-64-v3", "arch=x86-64-v4")))
+#else
+#define CLBRZCRCX8_MULTIVERSION
+#endif
+
+
+#ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+
+uint32_t clbrzcrcx8_crc_table [256] = {0};
+
+#else
+
+uint32_t clbrzcrcx8_crc_table[256] =
+{
+0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9, 0x130476dc, 0x17c56b6b, 0x1a864db2, 0x1e475005,
+0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61, 0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd,
+0x4c11db70, 0x48d0c6c7, 0x4593e01e, 0x4152fda9, 0x5f15adac, 0x5bd4b01b, 0x569796c2, 0x52568b75,
+0x6a1936c8, 0x6ed82b7f, 0x639b0da6, 0x675a1011, 0x791d4014, 0x7ddc5da3, 0x709f7b7a, 0x745e66cd,
+0x9823b6e0, 0x9ce2ab57, 0x91a18d8e, 0x95609039, 0x8b27c03c, 0x8fe6dd8b, 0x82a5fb52, 0x8664e6e5,
+0xbe2b5b58, 0xbaea46ef, 0xb7a96036, 0xb3687d81, 0xad2f2d84, 0xa9ee3033, 0xa4ad16ea, 0xa06c0b5d,
+0xd4326d90, 0xd0f37027, 0xddb056fe, 0xd9714b49, 0xc7361b4c, 0xc3f706fb, 0xceb42022, 0xca753d95,
+0xf23a8028, 0xf6fb9d9f, 0xfbb8bb46, 0xff79a6f1, 0xe13ef6f4, 0xe5ffeb43, 0xe8bccd9a, 0xec7dd02d,
+0x34867077, 0x30476dc0, 0x3d044b19, 0x39c556ae, 0x278206ab, 0x23431b1c, 0x2e003dc5, 0x2ac12072,
+0x128e9dcf, 0x164f8078, 0x1b0ca6a1, 0x1fcdbb16, 0x018aeb13, 0x054bf6a4, 0x0808d07d, 0x0cc9cdca,
+0x7897ab07, 0x7c56b6b0, 0x71159069, 0x75d48dde, 0x6b93dddb, 0x6f52c06c, 0x6211e6b5, 0x66d0fb02,
+0x5e9f46bf, 0x5a5e5b08, 0x571d7dd1, 0x53dc6066, 0x4d9b3063, 0x495a2dd4, 0x44190b0d, 0x40d816ba,
+0xaca5c697, 0xa864db20, 0xa527fdf9, 0xa1e6e04e, 0xbfa1b04b, 0xbb60adfc, 0xb6238b25, 0xb2e29692,
+0x8aad2b2f, 0x8e6c3698, 0x832f1041, 0x87ee0df6, 0x99a95df3, 0x9d684044, 0x902b669d, 0x94ea7b2a,
+0xe0b41de7, 0xe4750050, 0xe9362689, 0xedf73b3e, 0xf3b06b3b, 0xf771768c, 0xfa325055, 0xfef34de2,
+0xc6bcf05f, 0xc27dede8, 0xcf3ecb31, 0xcbffd686, 0xd5b88683, 0xd1799b34, 0xdc3abded, 0xd8fba05a,
+0x690ce0ee, 0x6dcdfd59, 0x608edb80, 0x644fc637, 0x7a089632, 0x7ec98b85, 0x738aad5c, 0x774bb0eb,
+0x4f040d56, 0x4bc510e1, 0x46863638, 0x42472b8f, 0x5c007b8a, 0x58c1663d, 0x558240e4, 0x51435d53,
+0x251d3b9e, 0x21dc2629, 0x2c9f00f0, 0x285e1d47, 0x36194d42, 0x32d850f5, 0x3f9b762c, 0x3b5a6b9b,
+0x0315d626, 0x07d4cb91, 0x0a97ed48, 0x0e56f0ff, 0x1011a0fa, 0x14d0bd4d, 0x19939b94, 0x1d528623,
+0xf12f560e, 0xf5ee4bb9, 0xf8ad6d60, 0xfc6c70d7, 0xe22b20d2, 0xe6ea3d65, 0xeba91bbc, 0xef68060b,
+0xd727bbb6, 0xd3e6a601, 0xdea580d8, 0xda649d6f, 0xc423cd6a, 0xc0e2d0dd, 0xcda1f604, 0xc960ebb3,
+0xbd3e8d7e, 0xb9ff90c9, 0xb4bcb610, 0xb07daba7, 0xae3afba2, 0xaafbe615, 0xa7b8c0cc, 0xa379dd7b,
+0x9b3660c6, 0x9ff77d71, 0x92b45ba8, 0x9675461f, 0x8832161a, 0x8cf30bad, 0x81b02d74, 0x857130c3,
+0x5d8a9099, 0x594b8d2e, 0x5408abf7, 0x50c9b640, 0x4e8ee645, 0x4a4ffbf2, 0x470cdd2b, 0x43cdc09c,
+0x7b827d21, 0x7f436096, 0x7200464f, 0x76c15bf8, 0x68860bfd, 0x6c47164a, 0x61043093, 0x65c52d24,
+0x119b4be9, 0x155a565e, 0x18197087, 0x1cd86d30, 0x029f3d35, 0x065e2082, 0x0b1d065b, 0x0fdc1bec,
+0x3793a651, 0x3352bbe6, 0x3e119d3f, 0x3ad08088, 0x2497d08d, 0x2056cd3a, 0x2d15ebe3, 0x29d4f654,
+0xc5a92679, 0xc1683bce, 0xcc2b1d17, 0xc8ea00a0, 0xd6ad50a5, 0xd26c4d12, 0xdf2f6bcb, 0xdbee767c,
+0xe3a1cbc1, 0xe760d676, 0xea23f0af, 0xeee2ed18, 0xf0a5bd1d, 0xf464a0aa, 0xf9278673, 0xfde69bc4,
+0x89b8fd09, 0x8d79e0be, 0x803ac667, 0x84fbdbd0, 0x9abc8bd5, 0x9e7d9662, 0x933eb0bb, 0x97ffad0c,
+0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668, 0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4,
+};
+
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+
+#endif // #ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+
+
+#define TOPBIT(width)	 		(1UL << (width-1UL))
+
+// this portable mask stuff was stolen from: http://www.zlib.net/crc_v3.txt, Ross Williams, avoid for e.g << 32 on a 32-bit machine !!
+// the original, naive stuff is commented below, followed by the magic way to do it right.
+//#define CRC_MASK(width)			((1 << (width)) - 1)
+#define CRC_MASK(width)			((((1UL<<(width-1))-1UL)<<1UL)|1UL)
+
+#define BITMASK(X) 				(1UL << (X))
+
+
+
+// byte bit-reversal table : clbrzcrcx8_reflect_byte_table[b] == reflect(b, 8), built by the preprocessor.
+#define REFLECT_BYTE_2(n)		(n), (n) + 2*64, (n) + 1*64, (n) + 3*64
+#define REFLECT_BYTE_4(n)		REFLECT_BYTE_2(n), REFLECT_BYTE_2((n) + 2*16), REFLECT_BYTE_2((n) + 1*16), REFLECT_BYTE_2((n) + 3*16)
+#define REFLECT_BYTE_6(n)		REFLECT_BYTE_4(n), REFLECT_BYTE_4((n) + 2*4), REFLECT_BYTE_4((n) + 1*4), REFLECT_BYTE_4((n) + 3*4)
+
+static const uint8_t clbrzcrcx8_reflect_byte_table[256] =
+{
+	REFLECT_BYTE_6(0), REFLECT_BYTE_6(2), REFLECT_BYTE_6(1), REFLECT_BYTE_6(3)
+};
+
+
+// all 32 bits reversed : the compiler builtin (clang), rbit (arm), or 4 byte table lookups.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bitreverse32)
+#define CLBRZCRCX8_HAVE_BUILTIN_BITREVERSE
+#endif
+#endif
+
+static inline uint32_t _clbrzcrcx8_reflect_32(uint32_t value)
+{
+#if defined(CLBRZCRCX8_HAVE_BUILTIN_BITREVERSE)
+	return __builtin_bitreverse32(value);
+#elif defined(__GNUC__) && (defined(__aarch64__) || (defined(__ARM_ARCH) && (__ARM_ARCH >= 7) && !defined(__thumb__)))
+	uint32_t reflected_value;
+	__asm__ ("rbit %0, %1" : "=r" (reflected_value) : "r" (value));
+	return reflected_value;
+#else
+	return	((uint32_t)clbrzcrcx8_reflect_byte_table[value & 0xff] << 24) |
+			((uint32_t)clbrzcrcx8_reflect_byte_table[(value >> 8) & 0xff] << 16) |
+			((uint32_t)clbrzcrcx8_reflect_byte_table[(value >> 16) & 0xff] << 8) |
+			(uint32_t)clbrzcrcx8_reflect_byte_table[value >> 24];
+#endif
+}
+
+
+// stolen from:  http://www.zlib.net/crc_v3.txt, Ross Williams.
+// Returns the value with the bottom b [0,n] bits reflected.
+// Example: reflect(0x3e23L,3) == 0x3e26
+// kept as the reference, and for bit counts beyond 32.
+static uint32_t _clbrzcrcx8_reflect_bitwise(uint32_t value, uint8_t num_bits_to_reflect)
+{
+	int bit_index;
+	uint32_t temp_value = value;
+	for (bit_index = 0; bit_index < num_bits_to_reflect; bit_index++)
+	{
+		if (temp_value & (uint32_t)1)
+		{
+			value |=  BITMASK((num_bits_to_reflect-1)-bit_index);
+		}
+		else
+		{
+			value &= ~BITMASK((num_bits_to_reflect-1)-bit_index);
+		}
+
+		temp_value >>= 1;
+	}
+
+	return value;
+}
+
+
+// same result as the bitwise loop above : bottom n bits reflected, the bits above them unchanged.
+uint32_t clbrzcrcx8_reflect(uint32_t value, uint8_t num_bits_to_reflect)
+{
+	if((num_bits_to_reflect == 0) || (num_bits_to_reflect > 32))
+	{
+		return _clbrzcrcx8_reflect_bitwise(value, num_bits_to_reflect);
+	}
+
+	return	(value & ~(uint32_t)CRC_MASK(num_bits_to_reflect)) |
+			(_clbrzcrcx8_reflect_32(value) >> (32 - num_bits_to_reflect));
+}
+
+
+#ifdef CLBRZCRCX8_HAVE_X86_SIMD
+// 32 bytes at a time : each byte is split in nibbles, both are reflected with pshufb and swapped over.
+__attribute__((target("avx2")))
+static size_t _clbrzcrcx8_reflect_buffer_avx2(uint8_t* destination, const uint8_t* source, size_t data_len)
+{
+	const __m256i reflect_nibble = _mm256_setr_epi8(0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf,
+													0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf);
+	const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+	__m256i data_bytes;
+	size_t byte_offset;
+
+	for (byte_offset = 0; byte_offset + 32 <= data_len; byte_offset += 32)
+	{
+		data_bytes = _mm256_loadu_si256((const __m256i*)(source + byte_offset));
+		data_bytes = _mm256_or_si256(
+						_mm256_slli_epi16(_mm256_shuffle_epi8(reflect_nibble, _mm256_and_si256(data_bytes, nibble_mask)), 4),
+						_mm256_shuffle_epi8(reflect_nibble, _mm256_and_si256(_mm256_srli_epi16(data_bytes, 4), nibble_mask)));
+		_mm256_storeu_si256((__m256i*)(destination + byte_offset), data_bytes);
+	}
+
+	return byte_offset;
+}
+#endif // #ifdef CLBRZCRCX8_HAVE_X86_SIMD
+
+
+void clbrzcrcx8_reflect_buffer(void* destination, const void* source, size_t data_len)
+{
+	uint8_t* destination_bytes = (uint8_t*)destination;
+	const uint8_t* source_bytes = (const uint8_t*)source;
+	size_t byte_index = 0;
+
+#ifdef CLBRZCRCX8_HAVE_X86_SIMD
+	if((data_len >= 32) && __builtin_cpu_supports("avx2"))
+	{
+		byte_index = _clbrzcrcx8_reflect_buffer_avx2(destination_bytes, source_bytes, data_len);
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_X86_SIMD
+
+	for (; byte_index < data_len; byte_index++)
+	{
+		destination_bytes[byte_index] = clbrzcrcx8_reflect_byte_table[source_bytes[byte_index]];
+	}
+}
+
+
+// INTERNAL FUNCTIONS
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+void _clbrzcrcx8_generate_crc_table(uint32_t generator_polynomial, uint8_t crc_width)
+{
+	uint16_t byte_value;
+	uint8_t bit_index;
+	uint32_t crc_value;
+
+	// iterate over all byte values 0 - 255
+	for (byte_value = 0; byte_value < 256; byte_value++)
+	{
+		// calculate the CRC-8 value for current byte
+
+		crc_value = (uint32_t)byte_value << (crc_width - 8); // move byte into MSB of 32Bit CRC
+
+		for (bit_index = 0; bit_index < 8; bit_index++)
+		{
+			if ((crc_value & TOPBIT(crc_width)) != 0)
+			{
+				crc_value = (crc_value << 1) ^ generator_polynomial;
+			}
+			else
+			{
+				crc_value <<= 1;
+			}
+		}
+		/* store CRC value in lookup table */
+		clbrzcrcx8_crc_table[byte_value] = (crc_value & CRC_MASK(crc_width));
+	}
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+
+
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+void _clbrzcrcx8_print_crc_table(uint8_t crc_width)
+{
+	uint16_t byte_value;
+
+	printf("clbrzcrcx8_crc_table[256] = \n{\n");
+
+	// iterate over all byte values 0 - 255
+	for (byte_value = 0; byte_value < 256; byte_value+=8)
+	{
+		// 4 bits = 1 hex, use format specifier * for variable based substitution
+		// https://stackoverflow.com/questions/5932214/printf-string-variable-length-item
+		printf("0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x, 0x%0*x,\n",
+															crc_width/4,clbrzcrcx8_crc_table[byte_value],
+															crc_width/4,clbrzcrcx8_crc_table[byte_value+1],
+															crc_width/4,clbrzcrcx8_crc_table[byte_value+2],
+															crc_width/4,clbrzcrcx8_crc_table[byte_value+3],
+															crc_width/4,clbrzcrcx8_crc_table[byte_value+4],
+															crc_width/4,clbrzcrcx8_crc_table[byte_value+5],
+															crc_width/4,clbrzcrcx8_crc_table[byte_value+6],
+															crc_width/4,clbrzcrcx8_crc_table[byte_value+7]);
+	}
+
+	printf("};\n\n");
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+// the tables only depend on (polynomial, width, refin).
+// refin=true algos get tables for the reflected (lsb-first) register, so there is no per-byte reflect in the loop.
+// refin=false algos get tables for the normal register, left-aligned to 32 bits, so all widths share one loop.
+
+// the tables are stored at their natural element width, so the L1 footprint of a table set is
+// SLICING_DEPTH * 256 * (1 for crc-8, 2 for crc-16, 4 for crc-24/32) bytes,
+// e.g. slicing-by-8 : 2 KiB for crc-8, 4 KiB for crc-16, 8 KiB for crc-32. slicing-by-4 halves that.
+
+#ifndef CLBRZCRCX8_SLICING_DEPTH
+#define CLBRZCRCX8_SLICING_DEPTH		8		// 8 = slicing-by-8, 4 = slicing-by-4, 1 = plain byte-wise table
+#endif // #ifndef CLBRZCRCX8_SLICING_DEPTH
+
+#if (CLBRZCRCX8_SLICING_DEPTH != 1) && (CLBRZCRCX8_SLICING_DEPTH != 4) && (CLBRZCRCX8_SLICING_DEPTH != 8)
+#error "CLBRZCRCX8_SLICING_DEPTH must be 1, 4 or 8"
+#endif
+
+#define TABLE_ELEMENT_SIZE(width)		(((width) <= 8) ? 1 : (((width) <= 16) ? 2 : 4))
+#define TABLE_SET_STORAGE_SIZE(width)	(CLBRZCRCX8_SLICING_DEPTH * 256 * TABLE_ELEMENT_SIZE(width))
+
+typedef struct _clbrzcrcx8_table_set
+{
+	uint32_t	polynomial;		// as in the descriptor (normal form, not reflected)
+	uint8_t		width;
+	uint8_t		reflected;		// 1 : tables are for the lsb-first register (refin=true)
+	const void*	table;			// [SLICING_DEPTH][256] of uint8_t/uint16_t/uint32_t, see TABLE_ELEMENT_SIZE()
+
+} clbrzcrcx8_table_set_t;
+
+
+#ifdef CLBRZCRCX8_USE_GENERATED_TABLES
+// const tables emitted at build time by the table generator (see Makefile), so they end up in rodata.
+// defines clbrzcrcx8_generated_table_sets[] and clbrzcrcx8_generated_table_sets_size.
+#include "clbrz_crcx8_tables.inc"
+#endif // #ifdef CLBRZCRCX8_USE_GENERATED_TABLES
+
+
+// slots that are filled once and then read without locks : EMPTY -> BUILDING -> READY, by the table cache and the calibration plans.
+#if defined(CLBRZCRCX8_ENABLE_TABLE_GENERATION) || defined(CLBRZCRCX8_ENABLE_CALIBRATION)
+
+#ifndef __STDC_NO_ATOMICS__
+#include <stdatomic.h>
+typedef atomic_uint clbrzcrcx8_slot_state_t;
+#define SLOT_STATE_LOAD(state)				atomic_load_explicit(&(state), memory_order_acquire)
+#define SLOT_STATE_PUBLISH(state, value)	atomic_store_explicit(&(state), (value), memory_order_release)
+#define SLOT_STATE_CLAIM(state, expected)	atomic_compare_exchange_strong_explicit(&(state), &(expected), SLOT_BUILDING, \
+																memory_order_acq_rel, memory_order_acquire)
+#else
+// no C11 atomics (old embedded toolchains) : still lazy and cached, but only safe from a single thread.
+typedef volatile unsigned int clbrzcrcx8_slot_state_t;
+#define SLOT_STATE_LOAD(state)				(state)
+#define SLOT_STATE_PUBLISH(state, value)	((state) = (value))
+#define SLOT_STATE_CLAIM(state, expected)	(((state) == (expected)) ? ((state) = SLOT_BUILDING, 1) : ((expected) = (state), 0))
+#endif // #ifndef __STDC_NO_ATOMICS__
+
+// spinning on a BUILDING slot : tell the cpu we are waiting, or give the core back to the scheduler,
+// the builder may have been preempted and is then only a timeslice away.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SLOT_STATE_RELAX()					__builtin_ia32_pause()
+#elif defined(__GNUC__) && (defined(__aarch64__) || (defined(__ARM_ARCH) && (__ARM_ARCH >= 7)))
+#define SLOT_STATE_RELAX()					__asm__ __volatile__("yield" ::: "memory")
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#define SLOT_STATE_RELAX()					sched_yield()
+#else
+#define SLOT_STATE_RELAX()					((void)0)
+#endif
+
+enum
+{
+	SLOT_EMPTY = 0,
+	SLOT_BUILDING,
+	SLOT_READY
+};
+
+// someone else is building the slot : wait until it is not BUILDING any more, returns the state it ended in.
+static unsigned int _clbrzcrcx8_slot_wait(clbrzcrcx8_slot_state_t* state_ptr, unsigned int slot_state)
+{
+	while(slot_state == SLOT_BUILDING)
+	{
+		SLOT_STATE_RELAX();
+		slot_state = SLOT_STATE_LOAD(*state_ptr);
+	}
+
+	return slot_state;
+}
+
+#endif // #if defined(CLBRZCRCX8_ENABLE_TABLE_GENERATION) || defined(CLBRZCRCX8_ENABLE_CALIBRATION)
+
+
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+
+// lazily generated, shared table cache, for everything not covered by the build time tables.
+// tables are generated once, on first use, and then shared read-only by every init_crc() with the same parameters, from any thread.
+// a slot goes EMPTY -> BUILDING -> READY exactly once, the thread that wins the EMPTY -> BUILDING CAS builds
+// the tables and publishes them with a release store, everyone else either finds the READY slot (acquire load)
+// or waits for the builder to finish. nothing is ever freed or rebuilt, so a READY slot can be read without locks.
+
+#ifndef CLBRZCRCX8_TABLE_CACHE_SLOTS
+#define CLBRZCRCX8_TABLE_CACHE_SLOTS	8		// max distinct (poly, width, refin) table sets, each is SLICING_DEPTH KiB
+#endif // #ifndef CLBRZCRCX8_TABLE_CACHE_SLOTS
+
+struct table_cache_slot
+{
+	clbrzcrcx8_slot_state_t state;
+	clbrzcrcx8_table_set_t table_set;
+	union	// only the first TABLE_SET_STORAGE_SIZE(width) bytes are ever touched
+	{
+		uint8_t		table_8[CLBRZCRCX8_SLICING_DEPTH][256];
+		uint16_t	table_16[CLBRZCRCX8_SLICING_DEPTH][256];
+		uint32_t	table_32[CLBRZCRCX8_SLICING_DEPTH][256];
+	} table_storage;
+};
+
+static struct table_cache_slot table_cache[CLBRZCRCX8_TABLE_CACHE_SLOTS];
+
+
+// stores a table entry at the natural element width, value is as the 32-bit engines see it.
+static void _clbrzcrcx8_store_table_entry(const clbrzcrcx8_table_set_t* table_set, void* table_storage,
+											uint8_t slice_index, uint8_t byte_value, uint32_t crc_value)
+{
+	switch(TABLE_ELEMENT_SIZE(table_set->width))
+	{
+		case 1:
+			((uint8_t (*)[256])table_storage)[slice_index][byte_value] = (uint8_t)(table_set->reflected ? crc_value : (crc_value >> 24));
+			break;
+		case 2:
+			((uint16_t (*)[256])table_storage)[slice_index][byte_value] = (uint16_t)(table_set->reflected ? crc_value : (crc_value >> 16));
+			break;
+		default:
+			((uint32_t (*)[256])table_storage)[slice_index][byte_value] = crc_value;
+			break;
+	}
+}
+
+// reads a table entry back, widened to what the 32-bit engines see.
+static uint32_t _clbrzcrcx8_load_table_entry(const clbrzcrcx8_table_set_t* table_set, const void* table_storage,
+												uint8_t slice_index, uint8_t byte_value)
+{
+	switch(TABLE_ELEMENT_SIZE(table_set->width))
+	{
+		case 1:
+			return (uint32_t)((const uint8_t (*)[256])table_storage)[slice_index][byte_value] << (table_set->reflected ? 0 : 24);
+		case 2:
+			return (uint32_t)((const uint16_t (*)[256])table_storage)[slice_index][byte_value] << (table_set->reflected ? 0 : 16);
+		default:
+			return ((const uint32_t (*)[256])table_storage)[slice_index][byte_value];
+	}
+}
+
+
+// builds all slices into table_storage (TABLE_SET_STORAGE_SIZE(width) bytes) and points the table set at it.
+static void _clbrzcrcx8_build_table_set(clbrzcrcx8_table_set_t* table_set, void* table_storage)
+{
+	uint16_t byte_value;
+	uint8_t bit_index;
+	uint8_t slice_index;
+	uint32_t crc_value;
+	uint32_t polynomial;
+
+	if(table_set->reflected == 1)
+	{
+		// reflected register : the crc sits in the low <width> bits, and shifts right.
+		polynomial = clbrzcrcx8_reflect(table_set->polynomial, table_set->width) & CRC_MASK(table_set->width);
+
+		for (byte_value = 0; byte_value < 256; byte_value++)
+		{
+			crc_value = byte_value;
+			for (bit_index = 0; bit_index < 8; bit_index++)
+			{
+				crc_value = (crc_value & 1) ? ((crc_value >> 1) ^ polynomial) : (crc_value >> 1);
+			}
+			_clbrzcrcx8_store_table_entry(table_set, table_storage, 0, (uint8_t)byte_value, crc_value);
+		}
+
+		// table[n][b] = crc of byte b followed by n zero bytes.
+		for (slice_index = 1; slice_index < CLBRZCRCX8_SLICING_DEPTH; slice_index++)
+		{
+			for (byte_value = 0; byte_value < 256; byte_value++)
+			{
+				crc_value = _clbrzcrcx8_load_table_entry(table_set, table_storage, slice_index - 1, (uint8_t)byte_value);
+				crc_value = (crc_value >> 8) ^ _clbrzcrcx8_load_table_entry(table_set, table_storage, 0, crc_value & 0xff);
+				_clbrzcrcx8_store_table_entry(table_set, table_storage, slice_index, (uint8_t)byte_value, crc_value);
+			}
+		}
+	}
+	else
+	{
+		// normal register, left-aligned into 32 bits : the crc msb is always bit 31, whatever the width.
+		polynomial = (table_set->polynomial & CRC_MASK(table_set->width)) << (32 - table_set->width);
+
+		for (byte_value = 0; byte_value < 256; byte_value++)
+		{
+			crc_value = (uint32_t)byte_value << 24;
+			for (bit_index = 0; bit_index < 8; bit_index++)
+			{
+				crc_value = (crc_value & 0x80000000UL) ? ((crc_value << 1) ^ polynomial) : (crc_value << 1);
+			}
+			_clbrzcrcx8_store_table_entry(table_set, table_storage, 0, (uint8_t)byte_value, crc_value);
+		}
+
+		for (slice_index = 1; slice_index < CLBRZCRCX8_SLICING_DEPTH; slice_index++)
+		{
+			for (byte_value = 0; byte_value < 256; byte_value++)
+			{
+				crc_value = _clbrzcrcx8_load_table_entry(table_set, table_storage, slice_index - 1, (uint8_t)byte_value);
+				crc_value = (crc_value << 8) ^ _clbrzcrcx8_load_table_entry(table_set, table_storage, 0, crc_value >> 24);
+				_clbrzcrcx8_store_table_entry(table_set, table_storage, slice_index, (uint8_t)byte_value, crc_value);
+			}
+		}
+	}
+
+	table_set->table = table_storage;
+}
+
+
+// returns the shared table set for the configuration, building it if this is the first use.
+// returns NULL only if the cache is full of other configurations.
+static const clbrzcrcx8_table_set_t* _clbrzcrcx8_get_table_set(uint32_t polynomial, uint8_t width, uint8_t reflected)
+{
+	unsigned int slot_index;
+	unsigned int probe_count;
+	unsigned int slot_state;
+	struct table_cache_slot* slot;
+
+	polynomial &= CRC_MASK(width);
+	slot_index = (unsigned int)((polynomial * 0x9e3779b1UL) ^ ((uint32_t)width << 1) ^ reflected) % CLBRZCRCX8_TABLE_CACHE_SLOTS;
+
+	for (probe_count = 0; probe_count < CLBRZCRCX8_TABLE_CACHE_SLOTS; probe_count++)
+	{
+		slot = &table_cache[slot_index];
+		slot_state = SLOT_STATE_LOAD(slot->state);
+
+		if(slot_state == SLOT_EMPTY)
+		{
+			if(SLOT_STATE_CLAIM(slot->state, slot_state))
+			{
+				slot->table_set.polynomial = polynomial;
+				slot->table_set.width = width;
+				slot->table_set.reflected = reflected;
+				_clbrzcrcx8_build_table_set(&slot->table_set, &slot->table_storage);
+				SLOT_STATE_PUBLISH(slot->state, SLOT_READY);
+
+				return &slot->table_set;
+			}
+			// lost the race, slot_state now holds what the other thread put there.
+		}
+
+		// key is only valid once READY, someone else is building it : wait, a few microseconds unless it got preempted.
+		slot_state = _clbrzcrcx8_slot_wait(&slot->state, slot_state);
+
+		if( slot->table_set.polynomial == polynomial &&
+			slot->table_set.width == width &&
+			slot->table_set.reflected == reflected )
+		{
+			return &slot->table_set;
+		}
+
+		slot_index = (slot_index + 1) % CLBRZCRCX8_TABLE_CACHE_SLOTS;
+	}
+
+	return NULL;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+
+
+// build time tables first, then the runtime cache. NULL if neither has (or can take) the configuration.
+static const clbrzcrcx8_table_set_t* _clbrzcrcx8_find_table_set(uint32_t polynomial, uint8_t width, uint8_t reflected)
+{
+#ifdef CLBRZCRCX8_USE_GENERATED_TABLES
+	int table_set_index;
+
+	for (table_set_index = 0; table_set_index < clbrzcrcx8_generated_table_sets_size; table_set_index++)
+	{
+		if( clbrzcrcx8_generated_table_sets[table_set_index].polynomial == (polynomial & CRC_MASK(width)) &&
+			clbrzcrcx8_generated_table_sets[table_set_index].width == width &&
+			clbrzcrcx8_generated_table_sets[table_set_index].reflected == reflected )
+		{
+			return &clbrzcrcx8_generated_table_sets[table_set_index];
+		}
+	}
+#endif // #ifdef CLBRZCRCX8_USE_GENERATED_TABLES
+
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+	return _clbrzcrcx8_get_table_set(polynomial, width, reflected);
+#else
+	return NULL;
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+}
+
+
+// the engines work on a 32-bit register, the compact table entries are widened on load.
+// reflected register : entries are the low <width> bits, used as is.
+// normal register : entries are the top bits of the left-aligned register, shifted back up.
+#define TABLE_LOOKUP_REFLECTED(slice, index)	((uint32_t)table[slice][index])
+#define TABLE_LOOKUP_NORMAL(slice, index)		((uint32_t)table[slice][index] << table_shift)
+
+static inline uint32_t _clbrzcrcx8_load_le32(const uint8_t* byte_data)
+{
+	return	(uint32_t)byte_data[0] | ((uint32_t)byte_data[1] << 8) |
+			((uint32_t)byte_data[2] << 16) | ((uint32_t)byte_data[3] << 24);
+}
+
+static inline uint32_t _clbrzcrcx8_load_be32(const uint8_t* byte_data)
+{
+	return	((uint32_t)byte_data[0] << 24) | ((uint32_t)byte_data[1] << 16) |
+			((uint32_t)byte_data[2] << 8) | (uint32_t)byte_data[3];
+}
+
+// the slicing loops run on aligned words : the bytes before the first aligned word go through the byte loop first.
+// the byte loads above are merged into one word load by the compiler, aligned words never straddle a cache line.
+#define SLICING_ALIGN_HEAD(byte_step)																		\
+		while((data_len >= CLBRZCRCX8_SLICING_DEPTH) &&														\
+				(((uintptr_t)byte_data & (CLBRZCRCX8_SLICING_DEPTH - 1)) != 0))								\
+		{																									\
+			byte_step;																						\
+			data_len--;																						\
+		}
+
+// one step = one word of CLBRZCRCX8_SLICING_DEPTH bytes at byte_data into calculated_crc, byte_data is not advanced.
+#if (CLBRZCRCX8_SLICING_DEPTH == 8)
+
+#define SLICING_STEP_REFLECTED																				\
+		{																									\
+			uint32_t word_lo = calculated_crc ^ _clbrzcrcx8_load_le32(byte_data);							\
+			uint32_t word_hi = _clbrzcrcx8_load_le32(byte_data + 4);										\
+																											\
+			calculated_crc =	TABLE_LOOKUP_REFLECTED(7, word_lo & 0xff) ^									\
+								TABLE_LOOKUP_REFLECTED(6, (word_lo >> 8) & 0xff) ^							\
+								TABLE_LOOKUP_REFLECTED(5, (word_lo >> 16) & 0xff) ^							\
+								TABLE_LOOKUP_REFLECTED(4, word_lo >> 24) ^									\
+								TABLE_LOOKUP_REFLECTED(3, word_hi & 0xff) ^									\
+								TABLE_LOOKUP_REFLECTED(2, (word_hi >> 8) & 0xff) ^							\
+								TABLE_LOOKUP_REFLECTED(1, (word_hi >> 16) & 0xff) ^							\
+								TABLE_LOOKUP_REFLECTED(0, word_hi >> 24);									\
+		}
+
+#define SLICING_STEP_NORMAL																					\
+		{																									\
+			uint32_t word_hi = calculated_crc ^ _clbrzcrcx8_load_be32(byte_data);							\
+			uint32_t word_lo = _clbrzcrcx8_load_be32(byte_data + 4);										\
+																											\
+			calculated_crc =	TABLE_LOOKUP_NORMAL(7, word_hi >> 24) ^										\
+								TABLE_LOOKUP_NORMAL(6, (word_hi >> 16) & 0xff) ^							\
+								TABLE_LOOKUP_NORMAL(5, (word_hi >> 8) & 0xff) ^								\
+								TABLE_LOOKUP_NORMAL(4, word_hi & 0xff) ^									\
+								TABLE_LOOKUP_NORMAL(3, word_lo >> 24) ^										\
+								TABLE_LOOKUP_NORMAL(2, (word_lo >> 16) & 0xff) ^							\
+								TABLE_LOOKUP_NORMAL(1, (word_lo >> 8) & 0xff) ^								\
+								TABLE_LOOKUP_NORMAL(0, word_lo & 0xff);										\
+		}
+
+#elif (CLBRZCRCX8_SLICING_DEPTH == 4)
+
+#define SLICING_STEP_REFLECTED																				\
+		{																									\
+			uint32_t word_lo = calculated_crc ^ _clbrzcrcx8_load_le32(byte_data);							\
+																											\
+			calculated_crc =	TABLE_LOOKUP_REFLECTED(3, word_lo & 0xff) ^									\
+								TABLE_LOOKUP_REFLECTED(2, (word_lo >> 8) & 0xff) ^							\
+								TABLE_LOOKUP_REFLECTED(1, (word_lo >> 16) & 0xff) ^							\
+								TABLE_LOOKUP_REFLECTED(0, word_lo >> 24);									\
+		}
+
+#define SLICING_STEP_NORMAL																					\
+		{																									\
+			uint32_t word_hi = calculated_crc ^ _clbrzcrcx8_load_be32(byte_data);							\
+																											\
+			calculated_crc =	TABLE_LOOKUP_NORMAL(3, word_hi >> 24) ^										\
+								TABLE_LOOKUP_NORMAL(2, (word_hi >> 16) & 0xff) ^							\
+								TABLE_LOOKUP_NORMAL(1, (word_hi >> 8) & 0xff) ^								\
+								TABLE_LOOKUP_NORMAL(0, word_hi & 0xff);										\
+		}
+
+#else
+
+#define SLICING_STEP_REFLECTED		calculated_crc = (calculated_crc >> 8) ^ TABLE_LOOKUP_REFLECTED(0, (calculated_crc ^ byte_data[0]) & 0xff);
+#define SLICING_STEP_NORMAL			calculated_crc = (calculated_crc << 8) ^ TABLE_LOOKUP_NORMAL(0, (calculated_crc >> 24) ^ byte_data[0]);
+
+#endif // #if (CLBRZCRCX8_SLICING_DEPTH == 8)
+
+#if (CLBRZCRCX8_SLICING_DEPTH > 1)
+
+#define SLICING_LOOP_REFLECTED																				\
+		while(data_len >= CLBRZCRCX8_SLICING_DEPTH)															\
+		{																									\
+			SLICING_STEP_REFLECTED																			\
+			byte_data += CLBRZCRCX8_SLICING_DEPTH;															\
+			data_len -= CLBRZCRCX8_SLICING_DEPTH;															\
+		}
+
+#define SLICING_LOOP_NORMAL																					\
+		while(data_len >= CLBRZCRCX8_SLICING_DEPTH)															\
+		{																									\
+			SLICING_STEP_NORMAL																				\
+			byte_data += CLBRZCRCX8_SLICING_DEPTH;															\
+			data_len -= CLBRZCRCX8_SLICING_DEPTH;															\
+		}
+
+#else
+
+#define SLICING_LOOP_REFLECTED
+#define SLICING_LOOP_NORMAL
+
+#endif // #if (CLBRZCRCX8_SLICING_DEPTH > 1)
+
+
+// one engine per table element type, the loops are the same, only the width of the table loads differs.
+// use_slicing 0 : one table lookup per byte, no alignment head, for the calibration to pick on short buffers.
+#define DEFINE_TABLE_SET_ENGINE(engine_name, element_type, use_slicing)										\
+CLBRZCRCX8_MULTIVERSION																						\
+static uint32_t engine_name(const clbrzcrcx8_table_set_t* table_set,										\
+							uint32_t calculated_crc,														\
+							const uint8_t* byte_data,														\
+							size_t data_len)																\
+{																											\
+	const element_type (*table)[256] = (const element_type (*)[256])table_set->table;						\
+	const unsigned int table_shift = 32 - 8 * sizeof(element_type);											\
+																											\
+	if(table_set->reflected == 1)																			\
+	{																										\
+		calculated_crc = clbrzcrcx8_reflect(calculated_crc, table_set->width) & CRC_MASK(table_set->width);	\
+																											\
+		if(use_slicing)																						\
+		{																									\
+			SLICING_ALIGN_HEAD(calculated_crc = (calculated_crc >> 8) ^ TABLE_LOOKUP_REFLECTED(0, (calculated_crc ^ *byte_data++) & 0xff))	\
+			SLICING_LOOP_REFLECTED																			\
+		}																									\
+																											\
+		while(data_len--)																					\
+		{																									\
+			calculated_crc = (calculated_crc >> 8) ^ TABLE_LOOKUP_REFLECTED(0, (calculated_crc ^ *byte_data++) & 0xff);	\
+		}																									\
+																											\
+		return clbrzcrcx8_reflect(calculated_crc, table_set->width) & CRC_MASK(table_set->width);			\
+	}																										\
+	else																									\
+	{																										\
+		calculated_crc <<= (32 - table_set->width);															\
+																											\
+		if(use_slicing)																						\
+		{																									\
+			SLICING_ALIGN_HEAD(calculated_crc = (calculated_crc << 8) ^ TABLE_LOOKUP_NORMAL(0, (calculated_crc >> 24) ^ *byte_data++))	\
+			SLICING_LOOP_NORMAL																				\
+		}																									\
+																											\
+		while(data_len--)																					\
+		{																									\
+			calculated_crc = (calculated_crc << 8) ^ TABLE_LOOKUP_NORMAL(0, (calculated_crc >> 24) ^ *byte_data++);	\
+		}																									\
+																											\
+		return calculated_crc >> (32 - table_set->width);													\
+	}																										\
+}
+
+DEFINE_TABLE_SET_ENGINE(_clbrzcrcx8_update_table_set_8, uint8_t, 1)
+DEFINE_TABLE_SET_ENGINE(_clbrzcrcx8_update_table_set_16, uint16_t, 1)
+DEFINE_TABLE_SET_ENGINE(_clbrzcrcx8_update_table_set_32, uint32_t, 1)
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+DEFINE_TABLE_SET_ENGINE(_clbrzcrcx8_update_table_set_bytewise_8, uint8_t, 0)
+DEFINE_TABLE_SET_ENGINE(_clbrzcrcx8_update_table_set_bytewise_16, uint16_t, 0)
+DEFINE_TABLE_SET_ENGINE(_clbrzcrcx8_update_table_set_bytewise_32, uint32_t, 0)
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+
+static uint32_t _clbrzcrcx8_update_table_set(const clbrzcrcx8_table_set_t* table_set,
+												uint32_t calculated_crc,
+												const uint8_t* byte_data,
+												size_t data_len)
+{
+	switch(TABLE_ELEMENT_SIZE(table_set->width))
+	{
+		case 1:
+			return _clbrzcrcx8_update_table_set_8(table_set, calculated_crc, byte_data, data_len);
+		case 2:
+			return _clbrzcrcx8_update_table_set_16(table_set, calculated_crc, byte_data, data_len);
+		default:
+			return _clbrzcrcx8_update_table_set_32(table_set, calculated_crc, byte_data, data_len);
+	}
+}
+
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+static uint32_t _clbrzcrcx8_update_table_set_bytewise(const clbrzcrcx8_table_set_t* table_set,
+														uint32_t calculated_crc,
+														const uint8_t* byte_data,
+														size_t data_len)
+{
+	switch(TABLE_ELEMENT_SIZE(table_set->width))
+	{
+		case 1:
+			return _clbrzcrcx8_update_table_set_bytewise_8(table_set, calculated_crc, byte_data, data_len);
+		case 2:
+			return _clbrzcrcx8_update_table_set_bytewise_16(table_set, calculated_crc, byte_data, data_len);
+		default:
+			return _clbrzcrcx8_update_table_set_bytewise_32(table_set, calculated_crc, byte_data, data_len);
+	}
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+
+
+// the byte loops below work on the normal (non-reflected) <width>-bit crc, input bytes are reflected on the way in if refin.
+#ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+CLBRZCRCX8_MULTIVERSION
+static uint32_t _clbrzcrcx8_update_global_table(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+												uint32_t calculated_crc,
+												const uint8_t* byte_data,
+												size_t data_len)
+{
+	size_t byte_data_index;
+
+	for(byte_data_index = 0; byte_data_index < data_len; byte_data_index++) // for each byte of data:
+	{
+		// xor in the next input byte, **at the MSB**
+		if(crc_configuration_ptr->reflect_input == 1)
+		{
+			calculated_crc ^= (uint32_t)clbrzcrcx8_reflect_byte_table[byte_data[byte_data_index]] << (crc_configuration_ptr->width-8);
+			calculated_crc = calculated_crc & CRC_MASK(crc_configuration_ptr->width);
+		}
+		else
+		{
+			calculated_crc ^= (uint32_t)byte_data[byte_data_index] << (crc_configuration_ptr->width-8);
+			calculated_crc = calculated_crc & CRC_MASK(crc_configuration_ptr->width);
+		}
+
+		// http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html
+		// (1)The important point is here that after xoring the current byte into the MSB of the intermediate CRC,
+		// the MSB is the index into the lookup table, so take ONLY MSB for lookup table index... this explains the crc_value >> (WIDTH-8)
+		// used for the lookup table.
+		// (2) now, as we are getting the value corresponding to MSB from the lookup table, drop the MSB from the crc
+		// i.e. shift the crc left, dropping the msb, then XOR this crc/remainder with the lookuptable value.
+		calculated_crc = (calculated_crc << 8) ^ (clbrzcrcx8_crc_table[calculated_crc >> (crc_configuration_ptr->width-8) ]);
+		calculated_crc = calculated_crc & CRC_MASK(crc_configuration_ptr->width);
+
+		// at this point, we have the calculated crc upto the current byte.
+	}
+
+	return calculated_crc;
+}
+#endif // #ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+
+
+// needs nothing but the descriptor, so it is also the reference every other engine is checked against.
+CLBRZCRCX8_MULTIVERSION
+static uint32_t _clbrzcrcx8_update_bitwise(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+											uint32_t calculated_crc,
+											const uint8_t* byte_data,
+											size_t data_len)
+{
+	size_t byte_data_index;
+	int32_t bit_index;
+
+	for(byte_data_index = 0; byte_data_index < data_len; byte_data_index++) // for each byte of data:
+	{
+		// xor in the next input byte, **at the MSB**
+		if(crc_configuration_ptr->reflect_input == 1)
+		{
+			calculated_crc ^= (uint32_t)clbrzcrcx8_reflect_byte_table[byte_data[byte_data_index]] << (crc_configuration_ptr->width-8);
+			calculated_crc = calculated_crc & CRC_MASK(crc_configuration_ptr->width);
+		}
+		else
+		{
+			calculated_crc ^= (uint32_t)byte_data[byte_data_index] << (crc_configuration_ptr->width-8);
+			calculated_crc = calculated_crc & CRC_MASK(crc_configuration_ptr->width);
+		}
+
+		// calculate crc by iterating over each bit of current byte and applying polynomial.
+		for (bit_index = 0; bit_index < 8; bit_index++)
+		{
+			// if the MSbit is 1, left-shift and apply the polynomial, else just left-shift
+			if ((calculated_crc & TOPBIT(crc_configuration_ptr->width)) != 0)
+			{
+				calculated_crc = ( ( (calculated_crc << 1) ^ crc_configuration_ptr->polynomial ) & CRC_MASK(crc_configuration_ptr->width) );
+			}
+			else
+			{
+				calculated_crc <<= 1;
+			}
+		}
+
+		// at this point, we have the calculated crc upto the current byte.
+	}
+
+	return calculated_crc;
+}
+
+
+// applies reflect_out and final_xor to an intermediate crc.
+static uint32_t _clbrzcrcx8_finalize(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, uint32_t calculated_crc)
+{
+	calculated_crc &= CRC_MASK(crc_configuration_ptr->width);
+
+	// xor with final_xor_value:
+	if(crc_configuration_ptr->reflect_output == 1)
+	{
+		calculated_crc =  clbrzcrcx8_reflect(calculated_crc,crc_configuration_ptr->width) & CRC_MASK(crc_configuration_ptr->width);
+		calculated_crc ^= crc_configuration_ptr->final_xor_value;
+	}
+	else
+	{
+		calculated_crc ^= crc_configuration_ptr->final_xor_value;
+	}
+
+	return calculated_crc;
+}
+
+
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+// CALIBRATION PLANS : one slot per calibrated (poly, width, refin), claimed once like a table cache slot.
+// the key is written once, before READY. the engines of a READY slot can be replaced later on (calibrate() or
+// set_calibration() again), so each engine is an atomic byte, read and written relaxed : every engine gives
+// the same crc, so a reader that sees half of the new plan only picks a slower engine, it never gets a wrong crc.
+
+#ifndef CLBRZCRCX8_CALIBRATION_SLOTS
+#define CLBRZCRCX8_CALIBRATION_SLOTS	16		// max distinct (poly, width, refin) with a plan, 24 bytes each
+#endif // #ifndef CLBRZCRCX8_CALIBRATION_SLOTS
+
+#define CALIBRATION_ENGINE_COUNT		3
+
+#ifndef __STDC_NO_ATOMICS__
+typedef atomic_uchar clbrzcrcx8_plan_engine_t;
+#define PLAN_ENGINE_LOAD(engine)			atomic_load_explicit(&(engine), memory_order_relaxed)
+#define PLAN_ENGINE_STORE(engine, value)	atomic_store_explicit(&(engine), (value), memory_order_relaxed)
+#else
+// no C11 atomics : single thread only, as the slots themselves.
+typedef volatile unsigned char clbrzcrcx8_plan_engine_t;
+#define PLAN_ENGINE_LOAD(engine)			(engine)
+#define PLAN_ENGINE_STORE(engine, value)	((engine) = (value))
+#endif // #ifndef __STDC_NO_ATOMICS__
+
+struct calibration_slot
+{
+	clbrzcrcx8_slot_state_t state;
+	uint32_t polynomial;
+	uint8_t width;
+	uint8_t reflected;
+	clbrzcrcx8_plan_engine_t engines[CLBRZCRCX8_CALIBRATION_SIZE_CLASSES];
+};
+
+static struct calibration_slot calibration_slots[CLBRZCRCX8_CALIBRATION_SLOTS];
+static clbrzcrcx8_slot_state_t calibration_in_use;		// READY once there is a plan : until then the update paths do not probe
+
+
+static unsigned int _clbrzcrcx8_calibration_slot_index(uint32_t polynomial, uint8_t width, uint8_t reflected)
+{
+	return (unsigned int)((polynomial * 0x9e3779b1UL) ^ ((uint32_t)width << 1) ^ reflected) % CLBRZCRCX8_CALIBRATION_SLOTS;
+}
+
+
+// the READY slot with the plan of the configuration, NULL if it has no plan.
+static struct calibration_slot* _clbrzcrcx8_find_plan(uint32_t polynomial, uint8_t width, uint8_t reflected)
+{
+	unsigned int slot_index;
+	unsigned int probe_count;
+	unsigned int slot_state;
+	struct calibration_slot* slot;
+
+	if(SLOT_STATE_LOAD(calibration_in_use) != SLOT_READY)
+	{
+		return NULL;
+	}
+
+	slot_index = _clbrzcrcx8_calibration_slot_index(polynomial, width, reflected);
+	for (probe_count = 0; probe_count < CLBRZCRCX8_CALIBRATION_SLOTS; probe_count++)
+	{
+		slot = &calibration_slots[slot_index];
+		slot_state = SLOT_STATE_LOAD(slot->state);
+
+		if(slot_state == SLOT_EMPTY)
+		{
+			return NULL;
+		}
+		// a plan still being stored is not there yet, the default engine will do meanwhile.
+		if( (slot_state == SLOT_READY) &&
+			(slot->polynomial == polynomial) && (slot->width == width) && (slot->reflected == reflected) )
+		{
+			return slot;
+		}
+
+		slot_index = (slot_index + 1) % CLBRZCRCX8_CALIBRATION_SLOTS;
+	}
+
+	return NULL;
+}
+
+
+// 1 : the plan is in use, 0 : every slot holds another configuration.
+static int _clbrzcrcx8_store_plan(const CLBRZCRCx8_CalibrationPlan_t* plan_ptr)
+{
+	unsigned int slot_index;
+	unsigned int probe_count;
+	unsigned int slot_state;
+	unsigned int size_class;
+	struct calibration_slot* slot;
+
+	slot_index = _clbrzcrcx8_calibration_slot_index(plan_ptr->polynomial, plan_ptr->width, plan_ptr->reflect_input);
+	for (probe_count = 0; probe_count < CLBRZCRCX8_CALIBRATION_SLOTS; probe_count++)
+	{
+		slot = &calibration_slots[slot_index];
+		slot_state = SLOT_STATE_LOAD(slot->state);
+
+		if(slot_state == SLOT_EMPTY)
+		{
+			if(SLOT_STATE_CLAIM(slot->state, slot_state))
+			{
+				slot->polynomial = plan_ptr->polynomial;
+				slot->width = plan_ptr->width;
+				slot->reflected = plan_ptr->reflect_input;
+				for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+				{
+					PLAN_ENGINE_STORE(slot->engines[size_class], plan_ptr->engines[size_class]);
+				}
+				SLOT_STATE_PUBLISH(slot->state, SLOT_READY);
+				SLOT_STATE_PUBLISH(calibration_in_use, SLOT_READY);
+
+				return 1;
+			}
+			// lost the race, slot_state now holds what the other thread put there.
+		}
+
+		slot_state = _clbrzcrcx8_slot_wait(&slot->state, slot_state);
+
+		if( (slot->polynomial == plan_ptr->polynomial) && (slot->width == plan_ptr->width) &&
+			(slot->reflected == plan_ptr->reflect_input) )
+		{
+			for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+			{
+				PLAN_ENGINE_STORE(slot->engines[size_class], plan_ptr->engines[size_class]);
+			}
+			return 1;
+		}
+
+		slot_index = (slot_index + 1) % CLBRZCRCX8_CALIBRATION_SLOTS;
+	}
+
+	return 0;
+}
+
+
+// class n : data_len in [2^n, 2^(n+1)), the last class takes everything longer.
+static unsigned int _clbrzcrcx8_size_class(size_t data_len)
+{
+	unsigned int size_class = 0;
+
+	while((size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES - 1) && ((data_len >> (size_class + 1)) != 0))
+	{
+		size_class++;
+	}
+
+	return size_class;
+}
+
+
+static uint32_t _clbrzcrcx8_run_engine(const clbrzcrcx8_table_set_t* table_set,
+										uint8_t engine,
+										uint32_t calculated_crc,
+										const uint8_t* byte_data,
+										size_t data_len)
+{
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+
+	switch(engine)
+	{
+		case CLBRZCRCX8_ENGINE_BITWISE:
+			// all the bitwise loop needs is in the table set key.
+			memset(&crc_configuration, 0, sizeof(crc_configuration));
+			crc_configuration.width = table_set->width;
+			crc_configuration.polynomial = table_set->polynomial;
+			crc_configuration.reflect_input = table_set->reflected;
+			return _clbrzcrcx8_update_bitwise(&crc_configuration, calculated_crc, byte_data, data_len);
+		case CLBRZCRCX8_ENGINE_TABLE:
+			return _clbrzcrcx8_update_table_set_bytewise(table_set, calculated_crc, byte_data, data_len);
+		default:
+			return _clbrzcrcx8_update_table_set(table_set, calculated_crc, byte_data, data_len);
+	}
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+// the table set engine of the single buffer update paths : the planned one for the length if the configuration is calibrated,
+// slicing otherwise.
+static uint32_t _clbrzcrcx8_update_planned(const clbrzcrcx8_table_set_t* table_set,
+											uint32_t calculated_crc,
+											const uint8_t* byte_data,
+											size_t data_len)
+{
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+	struct calibration_slot* slot = _clbrzcrcx8_find_plan(table_set->polynomial, table_set->width, table_set->reflected);
+
+	if(slot != NULL)
+	{
+		return _clbrzcrcx8_run_engine(table_set, PLAN_ENGINE_LOAD(slot->engines[_clbrzcrcx8_size_class(data_len)]),
+										calculated_crc, byte_data, data_len);
+	}
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+	return _clbrzcrcx8_update_table_set(table_set, calculated_crc, byte_data, data_len);
+}
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+
+
+// internal variables to keep track of chunked crc configuration
+// default config - CRC-32 : width=32 poly=0x04c11db7 init=0xffffffff refin=true refout=true xorout=0xffffffff check=0xcbf43926 name="CRC-32"
+
+struct crc_info
+{
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+	uint32_t calculated_crc;
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	const clbrzcrcx8_table_set_t* table_set;	// shared, read-only, NULL if no table set is available for the config
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+};
+
+// keep the currently configured crc and its state in memory.
+static
+struct crc_info current_crc_info =
+				{
+					{
+						"default",		// optional here, can be any string
+						32,
+						0x04c11db7,
+						0xffffffff,
+						0xffffffff,
+						1,
+						1,
+						0xcbf43926,		// optional here : check
+						0x00000000,		// optional here : residue
+					},
+					0xffffffff,
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+					NULL			// looked up on first init_crc()
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+				};
+
+
+void clbrzcrcx8_init_crc(CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr)
+{
+	current_crc_info.crc_configuration = (*crc_configuration_ptr);
+
+	current_crc_info.calculated_crc =
+			current_crc_info.crc_configuration.initial_value
+			&
+			CRC_MASK(current_crc_info.crc_configuration.width);
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	// re-init with the same parameters (the common case) does not even touch the cache.
+	if( current_crc_info.table_set == NULL ||
+		current_crc_info.table_set->polynomial != (current_crc_info.crc_configuration.polynomial & CRC_MASK(current_crc_info.crc_configuration.width)) ||
+		current_crc_info.table_set->width != current_crc_info.crc_configuration.width ||
+		current_crc_info.table_set->reflected != current_crc_info.crc_configuration.reflect_input )
+	{
+		current_crc_info.table_set = _clbrzcrcx8_find_table_set(current_crc_info.crc_configuration.polynomial,
+																current_crc_info.crc_configuration.width,
+																current_crc_info.crc_configuration.reflect_input);
+	}
+
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+	if(current_crc_info.table_set == NULL)
+	{
+		// cache is full of other configurations, fall back to the old way : one private table, generated on every init.
+		clbrzcrcx8_generate_crc_table();
+	}
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+}
+
+
+uint32_t clbrzcrcx8_calculate_crc_buffer(const void* data, size_t data_len)
+{
+	const uint8_t* byte_data = (const uint8_t*)data;
+
+	// start from previous CRC value
+	uint32_t calculated_crc =
+			current_crc_info.calculated_crc
+			&
+			CRC_MASK(current_crc_info.crc_configuration.width);
+
+	if(data_len > 0)
+	{
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		if(current_crc_info.table_set != NULL)
+		{
+			calculated_crc = _clbrzcrcx8_update_planned(current_crc_info.table_set, calculated_crc, byte_data, data_len);
+		}
+		else
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		{
+#ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+			calculated_crc = _clbrzcrcx8_update_global_table(&current_crc_info.crc_configuration, calculated_crc, byte_data, data_len);
+#else
+			calculated_crc = _clbrzcrcx8_update_bitwise(&current_crc_info.crc_configuration, calculated_crc, byte_data, data_len);
+#endif // #ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+		}
+	}
+
+	current_crc_info.calculated_crc  =	calculated_crc;
+
+	return current_crc_info.calculated_crc;
+}
+
+
+uint32_t clbrzcrcx8_calculate_crc_chunk(uint8_t* byte_data, int32_t data_len)
+{
+	// negative lengths were always ignored, keep it that way.
+	return clbrzcrcx8_calculate_crc_buffer(byte_data, (data_len > 0) ? (size_t)data_len : 0);
+}
+
+
+#ifdef CLBRZCRCX8_ENABLE_SCRUB
+
+// SCRUB : the data goes through calculate_crc_buffer() in steps, each step first prefetches the step that is
+// prefetch_distance bytes ahead. the non-temporal hint (prefetchnta on x86, pldl1strm on arm) keeps the lines close
+// to the core and out of (most of) the shared cache, so a pass over cold data does not evict the neighbours' hot data.
+// non-temporal loads proper (movntdqa) only bypass the cache on write-combining memory, on normal memory they are
+// plain loads, so the hint is all there is for buffers.
+// rate limit : after each step, if the scrub is ahead of bytes/sec by more than SCRUB_MIN_SLEEP_NS, sleep it off.
+
+#define SCRUB_STEP_SIZE				4096
+#define SCRUB_CACHE_LINE_SIZE		64
+#define SCRUB_MIN_SLEEP_NS			1000000ULL		// 1ms, shorter sleeps cost more than they save
+#define SCRUB_MAX_IDLE_NS			1000000000ULL	// idle for longer than this : do not bank the unused budget
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0)
+#define CLBRZCRCX8_HAVE_SCRUB_RATE_LIMIT
+#endif
+
+#if defined(__GNUC__)
+#define SCRUB_PREFETCH(address, non_temporal)	((non_temporal) ? __builtin_prefetch((address), 0, 0) : __builtin_prefetch((address), 0, 3))
+#else
+#define SCRUB_PREFETCH(address, non_temporal)	((void)(address), (void)(non_temporal))
+#endif // #if defined(__GNUC__)
+
+
+#ifdef CLBRZCRCX8_HAVE_SCRUB_RATE_LIMIT
+static uint64_t _clbrzcrcx8_scrub_now_ns()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+
+static void _clbrzcrcx8_scrub_throttle(CLBRZCRCx8_ScrubConfig_t* scrub_config_ptr, size_t step_len)
+{
+	uint64_t elapsed_ns;
+	uint64_t allowed_ns;
+	struct timespec sleep_time;
+
+	scrub_config_ptr->budget_bytes += step_len;
+	elapsed_ns = _clbrzcrcx8_scrub_now_ns() - scrub_config_ptr->budget_start_ns;
+	allowed_ns = (uint64_t)((double)scrub_config_ptr->budget_bytes * 1e9 / (double)scrub_config_ptr->rate_limit_bytes_per_sec);
+
+	if(allowed_ns >= elapsed_ns + SCRUB_MIN_SLEEP_NS)
+	{
+		sleep_time.tv_sec = (time_t)((allowed_ns - elapsed_ns) / 1000000000ULL);
+		sleep_time.tv_nsec = (long)((allowed_ns - elapsed_ns) % 1000000000ULL);
+		nanosleep(&sleep_time, NULL);
+	}
+	else if(elapsed_ns > allowed_ns + SCRUB_MAX_IDLE_NS)
+	{
+		// the caller was away (between files, say), start a new budget instead of bursting to catch up.
+		scrub_config_ptr->budget_start_ns = _clbrzcrcx8_scrub_now_ns();
+		scrub_config_ptr->budget_bytes = 0;
+	}
+}
+#endif // #ifdef CLBRZCRCX8_HAVE_SCRUB_RATE_LIMIT
+
+
+void clbrzcrcx8_init_scrub(CLBRZCRCx8_ScrubConfig_t* scrub_config_ptr,
+							size_t prefetch_distance,
+							uint8_t non_temporal,
+							uint64_t rate_limit_bytes_per_sec)
+{
+	scrub_config_ptr->prefetch_distance = prefetch_distance;
+	scrub_config_ptr->non_temporal = non_temporal;
+	scrub_config_ptr->rate_limit_bytes_per_sec = rate_limit_bytes_per_sec;
+	scrub_config_ptr->budget_bytes = 0;
+#ifdef CLBRZCRCX8_HAVE_SCRUB_RATE_LIMIT
+	scrub_config_ptr->budget_start_ns = _clbrzcrcx8_scrub_now_ns();
+#else
+	scrub_config_ptr->budget_start_ns = 0;
+#endif // #ifdef CLBRZCRCX8_HAVE_SCRUB_RATE_LIMIT
+}
+
+
+uint32_t clbrzcrcx8_calculate_crc_scrub(CLBRZCRCx8_ScrubConfig_t* scrub_config_ptr, const void* data, size_t data_len)
+{
+	const uint8_t* byte_data = (const uint8_t*)data;
+	const size_t prefetch_distance = scrub_config_ptr->prefetch_distance;
+	const uint8_t non_temporal = scrub_config_ptr->non_temporal;
+	size_t step_len;
+	size_t line_offset;
+
+	while(data_len > 0)
+	{
+		step_len = (data_len < SCRUB_STEP_SIZE) ? data_len : SCRUB_STEP_SIZE;
+
+		// the step prefetch_distance ahead, never past the end of the buffer.
+		// distance 0 with the non-temporal hint still marks the lines of this step before the crc loads them.
+		if((prefetch_distance > 0) || (non_temporal == 1))
+		{
+			for (line_offset = 0; (line_offset < step_len) && (prefetch_distance + line_offset < data_len); line_offset += SCRUB_CACHE_LINE_SIZE)
+			{
+				SCRUB_PREFETCH(byte_data + prefetch_distance + line_offset, non_temporal == 1);
+			}
+		}
+
+		clbrzcrcx8_calculate_crc_buffer(byte_data, step_len);
+		byte_data += step_len;
+		data_len -= step_len;
+
+#ifdef CLBRZCRCX8_HAVE_SCRUB_RATE_LIMIT
+		if(scrub_config_ptr->rate_limit_bytes_per_sec > 0)
+		{
+			_clbrzcrcx8_scrub_throttle(scrub_config_ptr, step_len);
+		}
+#endif // #ifdef CLBRZCRCX8_HAVE_SCRUB_RATE_LIMIT
+	}
+
+	return current_crc_info.calculated_crc;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_SCRUB
+
+
+uint32_t clbrzcrcx8_reset_crc_chunk()
+{
+	current_crc_info.calculated_crc =
+			current_crc_info.crc_configuration.initial_value
+			&
+			CRC_MASK(current_crc_info.crc_configuration.width);
+
+
+	return current_crc_info.calculated_crc;
+}
+
+
+uint32_t clbrzcrcx8_finalize_crc()
+{
+	current_crc_info.calculated_crc = _clbrzcrcx8_finalize(&current_crc_info.crc_configuration, current_crc_info.calculated_crc);
+
+	return current_crc_info.calculated_crc;
+}
+
+
+// COMBINE : the crc register is linear in the data, appending n bytes to A multiplies its register by x^(8n) mod poly :
+// reg(init, A || B) = reg(init, A) * x^(8n) ^ reg(0, B) and reg(init, B) = init * x^(8n) ^ reg(0, B), so
+// reg(init, A || B) = (reg(init, A) ^ init) * x^(8n) ^ reg(init, B). registers are the normal <width>-bit form.
+
+// a * b mod poly, normal form : bit <width - 1> is the highest power.
+static uint32_t _clbrzcrcx8_multiply_mod_poly(uint32_t a, uint32_t b, uint32_t polynomial, uint8_t width)
+{
+	uint32_t product = 0;
+	int bit_index;
+
+	for (bit_index = width - 1; bit_index >= 0; bit_index--)
+	{
+		product = (product & TOPBIT(width)) ? ((product << 1) ^ polynomial) : (product << 1);
+		product &= CRC_MASK(width);
+		if(b & BITMASK(bit_index))
+		{
+			product ^= a;
+		}
+	}
+
+	return product;
+}
+
+
+// x^(8 * byte_count) mod poly, square and multiply : at most 64 squarings, whatever the length.
+static uint32_t _clbrzcrcx8_x_pow_8n_mod_poly(uint64_t byte_count, uint32_t polynomial, uint8_t width)
+{
+	uint32_t result = 1;
+	uint32_t power = 1;
+	int bit_index;
+
+	polynomial &= CRC_MASK(width);
+
+	for (bit_index = 0; bit_index < 8; bit_index++)		// x^8 mod poly
+	{
+		power = (power & TOPBIT(width)) ? ((power << 1) ^ polynomial) : (power << 1);
+		power &= CRC_MASK(width);
+	}
+
+	while(byte_count != 0)
+	{
+		if(byte_count & 1)
+		{
+			result = _clbrzcrcx8_multiply_mod_poly(result, power, polynomial, width);
+		}
+		power = _clbrzcrcx8_multiply_mod_poly(power, power, polynomial, width);
+		byte_count >>= 1;
+	}
+
+	return result;
+}
+
+
+// undo _clbrzcrcx8_finalize() : complete crc back to the normal register.
+static uint32_t _clbrzcrcx8_unfinalize(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, uint32_t crc)
+{
+	crc = (crc ^ crc_configuration_ptr->final_xor_value) & CRC_MASK(crc_configuration_ptr->width);
+
+	if(crc_configuration_ptr->reflect_output == 1)
+	{
+		crc = clbrzcrcx8_reflect(crc, crc_configuration_ptr->width) & CRC_MASK(crc_configuration_ptr->width);
+	}
+
+	return crc;
+}
+
+
+uint32_t clbrzcrcx8_combine_crc(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+								uint32_t crc_a,
+								uint32_t crc_b,
+								uint64_t length_b)
+{
+	uint32_t polynomial = crc_configuration_ptr->polynomial & CRC_MASK(crc_configuration_ptr->width);
+	uint32_t register_a = _clbrzcrcx8_unfinalize(crc_configuration_ptr, crc_a);
+	uint32_t register_b = _clbrzcrcx8_unfinalize(crc_configuration_ptr, crc_b);
+	uint32_t initial_value = crc_configuration_ptr->initial_value & CRC_MASK(crc_configuration_ptr->width);
+
+	register_a = _clbrzcrcx8_multiply_mod_poly(register_a ^ initial_value,
+												_clbrzcrcx8_x_pow_8n_mod_poly(length_b, polynomial, crc_configuration_ptr->width),
+												polynomial, crc_configuration_ptr->width);
+
+	return _clbrzcrcx8_finalize(crc_configuration_ptr, register_a ^ register_b);
+}
+
+
+// BATCH : many independent, complete crcs (init .. finalize) in one call, without touching the init_crc() state.
+// on x86 with AVX2 (checked at runtime), records are run side by side, one per 32-bit SIMD lane :
+// crc-8 : 32 records at a time, crc-16 : 16 records, crc-17..32 : 8 records.
+// crc-8/16 look their tables up with pshufb on nibbles (the tables are linear : T[x] = T[x & 0x0f] ^ T[x & 0xf0]),
+// wider crcs use a gather from the 32-bit table. each group runs over the length common to all of its records,
+// the rest of every record, and any leftover records, go through the scalar engines.
+
+#if defined(CLBRZCRCX8_HAVE_X86_SIMD) && defined(CLBRZCRCX8_HAVE_TABLE_SETS)
+#define CLBRZCRCX8_HAVE_SIMD_BATCH
+#endif
+
+#ifdef CLBRZCRCX8_HAVE_SIMD_BATCH
+
+#define BATCH_LANES_PER_VECTOR	8		// 32-bit lanes in a ymm register
+#define BATCH_MAX_VECTORS		4		// crc-8 interleaves 4 vectors -> 32 records
+
+// register forms used in the lanes :
+// reflected : the reflected crc, in the low <width> bits. normal crc-8/16 : the crc itself.
+// normal crc-17..32 : the crc left-aligned to 32 bits, as the scalar table engines use it.
+static uint32_t _clbrzcrcx8_batch_to_lane(const clbrzcrcx8_table_set_t* table_set, uint32_t calculated_crc)
+{
+	if(table_set->reflected == 1)
+	{
+		return clbrzcrcx8_reflect(calculated_crc, table_set->width) & CRC_MASK(table_set->width);
+	}
+	return (table_set->width <= 16) ? calculated_crc : (calculated_crc << (32 - table_set->width));
+}
+
+static uint32_t _clbrzcrcx8_batch_from_lane(const clbrzcrcx8_table_set_t* table_set, uint32_t lane_crc)
+{
+	if(table_set->reflected == 1)
+	{
+		return clbrzcrcx8_reflect(lane_crc, table_set->width) & CRC_MASK(table_set->width);
+	}
+	return (table_set->width <= 16) ? lane_crc : (lane_crc >> (32 - table_set->width));
+}
+
+
+// next 4 bytes of 8 records, record n in lane n, first byte in the low byte.
+__attribute__((target("avx2")))
+static inline __m256i _clbrzcrcx8_batch_load4_avx2(const uint8_t* const* records, size_t byte_offset)
+{
+	uint32_t words[BATCH_LANES_PER_VECTOR];
+	int lane_index;
+
+	for (lane_index = 0; lane_index < BATCH_LANES_PER_VECTOR; lane_index++)
+	{
+		memcpy(&words[lane_index], records[lane_index] + byte_offset, 4);
+	}
+
+	return _mm256_set_epi32((int)words[7], (int)words[6], (int)words[5], (int)words[4],
+							(int)words[3], (int)words[2], (int)words[1], (int)words[0]);
+}
+
+
+// next 16 bytes of 8 records, transposed : words[k] holds bytes 4k..4k+3 of record n in lane n.
+__attribute__((target("avx2")))
+static inline void _clbrzcrcx8_batch_load16_avx2(const uint8_t* const* records, size_t byte_offset, __m256i* words)
+{
+	// rows 0..3 in the low 128-bit half, rows 4..7 in the high half, then a 4x4 dword transpose in each half.
+	__m256i rows_04 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(records[0] + byte_offset))),
+												_mm_loadu_si128((const __m128i*)(records[4] + byte_offset)), 1);
+	__m256i rows_15 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(records[1] + byte_offset))),
+												_mm_loadu_si128((const __m128i*)(records[5] + byte_offset)), 1);
+	__m256i rows_26 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(records[2] + byte_offset))),
+												_mm_loadu_si128((const __m128i*)(records[6] + byte_offset)), 1);
+	__m256i rows_37 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(records[3] + byte_offset))),
+												_mm_loadu_si128((const __m128i*)(records[7] + byte_offset)), 1);
+	__m256i words_01_lo = _mm256_unpacklo_epi32(rows_04, rows_15);
+	__m256i words_01_hi = _mm256_unpackhi_epi32(rows_04, rows_15);
+	__m256i words_23_lo = _mm256_unpacklo_epi32(rows_26, rows_37);
+	__m256i words_23_hi = _mm256_unpackhi_epi32(rows_26, rows_37);
+
+	words[0] = _mm256_unpacklo_epi64(words_01_lo, words_23_lo);
+	words[1] = _mm256_unpackhi_epi64(words_01_lo, words_23_lo);
+	words[2] = _mm256_unpacklo_epi64(words_01_hi, words_23_hi);
+	words[3] = _mm256_unpackhi_epi64(words_01_hi, words_23_hi);
+}
+
+
+// pshufb nibble tables of a crc-8/16 table set, see BATCH above.
+struct batch_nibble_tables
+{
+	__m256i lo_to_byte0;
+	__m256i lo_to_byte1;
+	__m256i hi_to_byte0;
+	__m256i hi_to_byte1;
+	int width;
+	int reflected;
+};
+
+// 4 bytes (one word per lane) into one vector of crc-8/16 lanes.
+__attribute__((target("avx2")))
+static inline __m256i _clbrzcrcx8_batch_nibble_step4_avx2(const struct batch_nibble_tables* nibble_tables, __m256i crcs, __m256i words)
+{
+	const __m256i byte_mask = _mm256_set1_epi32(0xff);
+	const __m256i nibble_mask = _mm256_set1_epi32(0x0f);
+	const __m256i to_byte0 = _mm256_set1_epi32((int)0x80808000);	// pshufb : 0x80 zeroes the byte
+	const __m256i to_byte1 = _mm256_set1_epi32((int)0x80800080);
+	const __m256i crc_mask = _mm256_set1_epi32((nibble_tables->width == 8) ? 0xff : 0xffff);
+	__m256i index, lo_nibble, hi_nibble, table_value;
+	int byte_index;
+
+	for (byte_index = 0; byte_index < 4; byte_index++)
+	{
+		if(nibble_tables->reflected == 1)
+		{
+			index = _mm256_and_si256(_mm256_xor_si256(crcs, words), byte_mask);
+			crcs = _mm256_srli_epi32(crcs, 8);
+		}
+		else
+		{
+			index = _mm256_and_si256(_mm256_xor_si256((nibble_tables->width == 8) ? crcs : _mm256_srli_epi32(crcs, 8), words), byte_mask);
+			crcs = _mm256_and_si256(_mm256_slli_epi32(crcs, 8), crc_mask);
+		}
+		words = _mm256_srli_epi32(words, 8);
+
+		lo_nibble = _mm256_and_si256(index, nibble_mask);
+		hi_nibble = _mm256_srli_epi32(index, 4);
+		table_value = _mm256_xor_si256(_mm256_shuffle_epi8(nibble_tables->lo_to_byte0, _mm256_or_si256(lo_nibble, to_byte0)),
+										_mm256_shuffle_epi8(nibble_tables->hi_to_byte0, _mm256_or_si256(hi_nibble, to_byte0)));
+		if(nibble_tables->width == 16)
+		{
+			table_value = _mm256_xor_si256(table_value,
+							_mm256_xor_si256(_mm256_shuffle_epi8(nibble_tables->lo_to_byte1, _mm256_or_si256(_mm256_slli_epi32(lo_nibble, 8), to_byte1)),
+											_mm256_shuffle_epi8(nibble_tables->hi_to_byte1, _mm256_or_si256(_mm256_slli_epi32(hi_nibble, 8), to_byte1))));
+		}
+		crcs = _mm256_xor_si256(crcs, table_value);
+	}
+
+	return crcs;
+}
+
+
+// crc-8 and crc-16 : vector_count vectors of 8 lanes each, over common_len bytes (multiple of 4).
+__attribute__((target("avx2")))
+static void _clbrzcrcx8_batch_nibble_avx2(const clbrzcrcx8_table_set_t* table_set,
+											const uint8_t* const* records,
+											size_t common_len,
+											uint32_t* lane_crcs,
+											int vector_count)
+{
+	uint8_t nibble_bytes[4][16];		// low nibble -> crc byte 0, low nibble -> crc byte 1, high nibble -> byte 0, byte 1
+	struct batch_nibble_tables nibble_tables;
+	uint32_t table_entry;
+	int nibble;
+	int vector_index;
+	int word_index;
+	size_t byte_offset = 0;
+	__m256i crcs[BATCH_MAX_VECTORS];
+	__m256i words[BATCH_MAX_VECTORS][4];
+
+	for (nibble = 0; nibble < 16; nibble++)
+	{
+		table_entry = (table_set->width == 8) ? ((const uint8_t*)table_set->table)[nibble] : ((const uint16_t*)table_set->table)[nibble];
+		nibble_bytes[0][nibble] = (uint8_t)table_entry;
+		nibble_bytes[1][nibble] = (uint8_t)(table_entry >> 8);
+		table_entry = (table_set->width == 8) ? ((const uint8_t*)table_set->table)[nibble << 4] : ((const uint16_t*)table_set->table)[nibble << 4];
+		nibble_bytes[2][nibble] = (uint8_t)table_entry;
+		nibble_bytes[3][nibble] = (uint8_t)(table_entry >> 8);
+	}
+	nibble_tables.lo_to_byte0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)nibble_bytes[0]));
+	nibble_tables.lo_to_byte1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)nibble_bytes[1]));
+	nibble_tables.hi_to_byte0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)nibble_bytes[2]));
+	nibble_tables.hi_to_byte1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)nibble_bytes[3]));
+	nibble_tables.width = table_set->width;
+	nibble_tables.reflected = table_set->reflected;
+
+	for (vector_index = 0; vector_index < vector_count; vector_index++)
+	{
+		crcs[vector_index] = _mm256_loadu_si256((const __m256i*)&lane_crcs[vector_index * BATCH_LANES_PER_VECTOR]);
+	}
+
+	for (; byte_offset + 16 <= common_len; byte_offset += 16)
+	{
+		for (vector_index = 0; vector_index < vector_count; vector_index++)
+		{
+			_clbrzcrcx8_batch_load16_avx2(&records[vector_index * BATCH_LANES_PER_VECTOR], byte_offset, words[vector_index]);
+		}
+
+		for (word_index = 0; word_index < 4; word_index++)
+		{
+			// independent vectors, so the pshufb latencies of one overlap with the others.
+			for (vector_index = 0; vector_index < vector_count; vector_index++)
+			{
+				crcs[vector_index] = _clbrzcrcx8_batch_nibble_step4_avx2(&nibble_tables, crcs[vector_index], words[vector_index][word_index]);
+			}
+		}
+	}
+
+	for (; byte_offset < common_len; byte_offset += 4)
+	{
+		for (vector_index = 0; vector_index < vector_count; vector_index++)
+		{
+			crcs[vector_index] = _clbrzcrcx8_batch_nibble_step4_avx2(&nibble_tables, crcs[vector_index],
+										_clbrzcrcx8_batch_load4_avx2(&records[vector_index * BATCH_LANES_PER_VECTOR], byte_offset));
+		}
+	}
+
+	for (vector_index = 0; vector_index < vector_count; vector_index++)
+	{
+		_mm256_storeu_si256((__m256i*)&lane_crcs[vector_index * BATCH_LANES_PER_VECTOR], crcs[vector_index]);
+	}
+}
+
+
+// 4 bytes (one word per lane) into crc-17..32 lanes, slicing-by-4 with gathers : the 4 lookups are independent.
+__attribute__((target("avx2")))
+static inline __m256i _clbrzcrcx8_batch_gather_step4_avx2(const clbrzcrcx8_table_set_t* table_set, __m256i crcs, __m256i words)
+{
+	const int* table = (const int*)table_set->table;
+	const __m256i byte_mask = _mm256_set1_epi32(0xff);
+	const __m256i byte_swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+												3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+	__m256i index;
+	int byte_index;
+
+#if (CLBRZCRCX8_SLICING_DEPTH >= 4)
+	if(table_set->reflected == 1)
+	{
+		words = _mm256_xor_si256(crcs, words);
+		return _mm256_xor_si256(
+				_mm256_xor_si256(_mm256_i32gather_epi32(table + 3 * 256, _mm256_and_si256(words, byte_mask), 4),
+								_mm256_i32gather_epi32(table + 2 * 256, _mm256_and_si256(_mm256_srli_epi32(words, 8), byte_mask), 4)),
+				_mm256_xor_si256(_mm256_i32gather_epi32(table + 1 * 256, _mm256_and_si256(_mm256_srli_epi32(words, 16), byte_mask), 4),
+								_mm256_i32gather_epi32(table, _mm256_srli_epi32(words, 24), 4)));
+	}
+	else
+	{
+		words = _mm256_xor_si256(crcs, _mm256_shuffle_epi8(words, byte_swap));
+		return _mm256_xor_si256(
+				_mm256_xor_si256(_mm256_i32gather_epi32(table + 3 * 256, _mm256_srli_epi32(words, 24), 4),
+								_mm256_i32gather_epi32(table + 2 * 256, _mm256_and_si256(_mm256_srli_epi32(words, 16), byte_mask), 4)),
+				_mm256_xor_si256(_mm256_i32gather_epi32(table + 1 * 256, _mm256_and_si256(_mm256_srli_epi32(words, 8), byte_mask), 4),
+								_mm256_i32gather_epi32(table, _mm256_and_si256(words, byte_mask), 4)));
+	}
+#endif // #if (CLBRZCRCX8_SLICING_DEPTH >= 4)
+
+	// byte-wise tables only : 4 dependent gathers.
+	(void)byte_swap;
+	for (byte_index = 0; byte_index < 4; byte_index++)
+	{
+		if(table_set->reflected == 1)
+		{
+			index = _mm256_and_si256(_mm256_xor_si256(crcs, words), byte_mask);
+			crcs = _mm256_xor_si256(_mm256_srli_epi32(crcs, 8), _mm256_i32gather_epi32(table, index, 4));
+		}
+		else
+		{
+			index = _mm256_and_si256(_mm256_xor_si256(_mm256_srli_epi32(crcs, 24), words), byte_mask);
+			crcs = _mm256_xor_si256(_mm256_slli_epi32(crcs, 8), _mm256_i32gather_epi32(table, index, 4));
+		}
+		words = _mm256_srli_epi32(words, 8);
+	}
+
+	return crcs;
+}
+
+
+// crc-17..32 : 8 lanes, table lookups are gathers from the 32-bit tables.
+__attribute__((target("avx2")))
+static void _clbrzcrcx8_batch_gather_avx2(const clbrzcrcx8_table_set_t* table_set,
+											const uint8_t* const* records,
+											size_t common_len,
+											uint32_t* lane_crcs)
+{
+	size_t byte_offset = 0;
+	int word_index;
+	__m256i crcs = _mm256_loadu_si256((const __m256i*)lane_crcs);
+	__m256i words[4];
+
+	for (; byte_offset + 16 <= common_len; byte_offset += 16)
+	{
+		_clbrzcrcx8_batch_load16_avx2(records, byte_offset, words);
+		for (word_index = 0; word_index < 4; word_index++)
+		{
+			crcs = _clbrzcrcx8_batch_gather_step4_avx2(table_set, crcs, words[word_index]);
+		}
+	}
+
+	for (; byte_offset < common_len; byte_offset += 4)
+	{
+		crcs = _clbrzcrcx8_batch_gather_step4_avx2(table_set, crcs, _clbrzcrcx8_batch_load4_avx2(records, byte_offset));
+	}
+
+	_mm256_storeu_si256((__m256i*)lane_crcs, crcs);
+}
+
+
+// runs one group of records through the SIMD lanes, returns the number of records done (0 if none).
+static size_t _clbrzcrcx8_batch_group_avx2(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+											const clbrzcrcx8_table_set_t* table_set,
+											const uint8_t* const* records,
+											const size_t* record_lengths,
+											uint32_t* crcs,
+											size_t record_count)
+{
+	uint32_t lane_crcs[BATCH_LANES_PER_VECTOR * BATCH_MAX_VECTORS];
+	int vector_count;
+	size_t lane_count;
+	size_t lane_index;
+	size_t common_len;
+	uint32_t calculated_crc;
+
+	if(table_set->width == 8)
+	{
+		vector_count = 4;
+	}
+	else if(table_set->width == 16)
+	{
+		vector_count = 2;
+	}
+	else if(table_set->width > 16 && TABLE_ELEMENT_SIZE(table_set->width) == 4)
+	{
+		vector_count = 1;
+	}
+	else
+	{
+		return 0;
+	}
+
+	lane_count = (size_t)vector_count * BATCH_LANES_PER_VECTOR;
+	if(record_count < lane_count || !__builtin_cpu_supports("avx2"))
+	{
+		return 0;
+	}
+
+	common_len = record_lengths[0];
+	for (lane_index = 0; lane_index < lane_count; lane_index++)
+	{
+		if(record_lengths[lane_index] < common_len)
+		{
+			common_len = record_lengths[lane_index];
+		}
+		lane_crcs[lane_index] = _clbrzcrcx8_batch_to_lane(table_set, crc_configuration_ptr->initial_value & CRC_MASK(table_set->width));
+	}
+	common_len &= ~(size_t)3;
+
+	if(vector_count == 1)
+	{
+		_clbrzcrcx8_batch_gather_avx2(table_set, records, common_len, lane_crcs);
+	}
+	else
+	{
+		_clbrzcrcx8_batch_nibble_avx2(table_set, records, common_len, lane_crcs, vector_count);
+	}
+
+	for (lane_index = 0; lane_index < lane_count; lane_index++)
+	{
+		calculated_crc = _clbrzcrcx8_batch_from_lane(table_set, lane_crcs[lane_index]);
+		if(record_lengths[lane_index] != common_len)
+		{
+			calculated_crc = _clbrzcrcx8_update_table_set(table_set, calculated_crc,
+															records[lane_index] + common_len,
+															record_lengths[lane_index] - common_len);
+		}
+		crcs[lane_index] = _clbrzcrcx8_finalize(crc_configuration_ptr, calculated_crc);
+	}
+
+	return lane_count;
+}
+
+#endif // #ifdef CLBRZCRCX8_HAVE_SIMD_BATCH
+
+
+void clbrzcrcx8_calculate_crc_batch(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+									const uint8_t* const* records,
+									const size_t* record_lengths,
+									uint32_t* crcs,
+									size_t record_count)
+{
+	size_t record_index = 0;
+	uint32_t calculated_crc;
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	const clbrzcrcx8_table_set_t* table_set = _clbrzcrcx8_find_table_set(crc_configuration_ptr->polynomial,
+																		crc_configuration_ptr->width,
+																		crc_configuration_ptr->reflect_input);
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+#ifdef CLBRZCRCX8_HAVE_SIMD_BATCH
+	size_t group_size;
+
+	if(table_set != NULL)
+	{
+		do
+		{
+			group_size = _clbrzcrcx8_batch_group_avx2(crc_configuration_ptr, table_set,
+														&records[record_index], &record_lengths[record_index],
+														&crcs[record_index], record_count - record_index);
+			record_index += group_size;
+		}
+		while(group_size != 0);
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_SIMD_BATCH
+
+	for (; record_index < record_count; record_index++)
+	{
+		calculated_crc = crc_configuration_ptr->initial_value & CRC_MASK(crc_configuration_ptr->width);
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		if(table_set != NULL)
+		{
+			calculated_crc = _clbrzcrcx8_update_planned(table_set, calculated_crc, records[record_index], record_lengths[record_index]);
+		}
+		else
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		{
+			// the global table belongs to the init_crc() configuration, so the batch never uses it.
+			calculated_crc = _clbrzcrcx8_update_bitwise(crc_configuration_ptr, calculated_crc, records[record_index], record_lengths[record_index]);
+		}
+		crcs[record_index] = _clbrzcrcx8_finalize(crc_configuration_ptr, calculated_crc);
+	}
+}
+
+
+uint32_t clbrzcrcx8_calculate_crc(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, const void* data, size_t data_len)
+{
+	const uint8_t* record = (const uint8_t*)data;
+	uint32_t crc;
+
+	clbrzcrcx8_calculate_crc_batch(crc_configuration_ptr, &record, &data_len, &crc, 1);
+
+	return crc;
+}
+
+
+// STATE : the register lives in the caller's CLBRZCRCx8_CRCState_t, the table set is looked up per call
+// (the state must not hold pointers), which is a hash probe in the shared table cache.
+
+static void _clbrzcrcx8_state_to_descriptor(const CLBRZCRCx8_CRCState_t* crc_state_ptr, CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr)
+{
+	memset(crc_configuration_ptr, 0, sizeof(*crc_configuration_ptr));
+	crc_configuration_ptr->width = crc_state_ptr->width;
+	crc_configuration_ptr->polynomial = crc_state_ptr->polynomial;
+	crc_configuration_ptr->initial_value = crc_state_ptr->initial_value;
+	crc_configuration_ptr->final_xor_value = crc_state_ptr->final_xor_value;
+	crc_configuration_ptr->reflect_input = crc_state_ptr->reflect_input;
+	crc_configuration_ptr->reflect_output = crc_state_ptr->reflect_output;
+}
+
+
+void clbrzcrcx8_init_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr, const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr)
+{
+	memset(crc_state_ptr, 0, sizeof(*crc_state_ptr));
+	crc_state_ptr->width = crc_configuration_ptr->width;
+	crc_state_ptr->polynomial = crc_configuration_ptr->polynomial & CRC_MASK(crc_configuration_ptr->width);
+	crc_state_ptr->initial_value = crc_configuration_ptr->initial_value & CRC_MASK(crc_configuration_ptr->width);
+	crc_state_ptr->final_xor_value = crc_configuration_ptr->final_xor_value;
+	crc_state_ptr->reflect_input = crc_configuration_ptr->reflect_input;
+	crc_state_ptr->reflect_output = crc_configuration_ptr->reflect_output;
+	crc_state_ptr->crc_register = crc_state_ptr->initial_value;
+}
+
+
+uint32_t clbrzcrcx8_update_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr, const void* data, size_t data_len)
+{
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	const clbrzcrcx8_table_set_t* table_set;
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+	if(data_len == 0)
+	{
+		return crc_state_ptr->crc_register;
+	}
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	table_set = _clbrzcrcx8_find_table_set(crc_state_ptr->polynomial, crc_state_ptr->width, crc_state_ptr->reflect_input);
+	if(table_set != NULL)
+	{
+		crc_state_ptr->crc_register = _clbrzcrcx8_update_planned(table_set, crc_state_ptr->crc_register, (const uint8_t*)data, data_len);
+	}
+	else
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	{
+		// the global table belongs to the init_crc() configuration, so a state never uses it.
+		_clbrzcrcx8_state_to_descriptor(crc_state_ptr, &crc_configuration);
+		crc_state_ptr->crc_register = _clbrzcrcx8_update_bitwise(&crc_configuration, crc_state_ptr->crc_register, (const uint8_t*)data, data_len);
+	}
+	crc_state_ptr->byte_count += data_len;
+
+	return crc_state_ptr->crc_register;
+}
+
+
+uint32_t clbrzcrcx8_finalize_crc_state(const CLBRZCRCx8_CRCState_t* crc_state_ptr)
+{
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+
+	_clbrzcrcx8_state_to_descriptor(crc_state_ptr, &crc_configuration);
+
+	return _clbrzcrcx8_finalize(&crc_configuration, crc_state_ptr->crc_register);
+}
+
+
+void clbrzcrcx8_reset_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr)
+{
+	crc_state_ptr->crc_register = crc_state_ptr->initial_value;
+	crc_state_ptr->byte_count = 0;
+}
+
+
+// CHECKPOINT : field offsets of the exported state, see the header. the record is protected by CRC-32C.
+#define CHECKPOINT_MAGIC			0
+#define CHECKPOINT_VERSION			4
+#define CHECKPOINT_WIDTH			5
+#define CHECKPOINT_REFLECT_INPUT	6
+#define CHECKPOINT_REFLECT_OUTPUT	7
+#define CHECKPOINT_POLYNOMIAL		8
+#define CHECKPOINT_INITIAL_VALUE	12
+#define CHECKPOINT_FINAL_XOR_VALUE	16
+#define CHECKPOINT_REGISTER			20
+#define CHECKPOINT_BYTE_COUNT		24
+#define CHECKPOINT_CHECK			32
+
+#define CHECKPOINT_FORMAT_VERSION	1
+
+static const uint8_t checkpoint_magic[4] = { 'C', 'R', 'C', 'K' };
+
+// checkpoints, block store metadata and calibration files, see clbrz_crcx8_internal.h
+const CLBRZCRCx8_CRCTypeDescriptor_t _clbrzcrcx8_metadata_crc =
+		{ "CRC-32C", 32, 0x1edc6f41, 0xffffffff, 0xffffffff, 1, 1, 0xe3069283, 0 };
+
+
+void clbrzcrcx8_export_crc_state(const CLBRZCRCx8_CRCState_t* crc_state_ptr, uint8_t checkpoint[CLBRZCRCX8_CHECKPOINT_SIZE])
+{
+	memcpy(&checkpoint[CHECKPOINT_MAGIC], checkpoint_magic, sizeof(checkpoint_magic));
+	checkpoint[CHECKPOINT_VERSION] = CHECKPOINT_FORMAT_VERSION;
+	checkpoint[CHECKPOINT_WIDTH] = crc_state_ptr->width;
+	checkpoint[CHECKPOINT_REFLECT_INPUT] = crc_state_ptr->reflect_input;
+	checkpoint[CHECKPOINT_REFLECT_OUTPUT] = crc_state_ptr->reflect_output;
+	_clbrzcrcx8_put_le(&checkpoint[CHECKPOINT_POLYNOMIAL], crc_state_ptr->polynomial, 4);
+	_clbrzcrcx8_put_le(&checkpoint[CHECKPOINT_INITIAL_VALUE], crc_state_ptr->initial_value, 4);
+	_clbrzcrcx8_put_le(&checkpoint[CHECKPOINT_FINAL_XOR_VALUE], crc_state_ptr->final_xor_value, 4);
+	_clbrzcrcx8_put_le(&checkpoint[CHECKPOINT_REGISTER], crc_state_ptr->crc_register, 4);
+	_clbrzcrcx8_put_le(&checkpoint[CHECKPOINT_BYTE_COUNT], crc_state_ptr->byte_count, 8);
+	_clbrzcrcx8_put_le(&checkpoint[CHECKPOINT_CHECK], clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, checkpoint, CHECKPOINT_CHECK), 4);
+}
+
+
+int clbrzcrcx8_import_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr,
+								const uint8_t checkpoint[CLBRZCRCX8_CHECKPOINT_SIZE],
+								const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr)
+{
+	CLBRZCRCx8_CRCState_t imported_state;
+
+	if( (memcmp(&checkpoint[CHECKPOINT_MAGIC], checkpoint_magic, sizeof(checkpoint_magic)) != 0) ||
+		(checkpoint[CHECKPOINT_VERSION] != CHECKPOINT_FORMAT_VERSION) ||
+		(_clbrzcrcx8_get_le(&checkpoint[CHECKPOINT_CHECK], 4) != clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, checkpoint, CHECKPOINT_CHECK)) ||
+		(checkpoint[CHECKPOINT_WIDTH] < 8) || (checkpoint[CHECKPOINT_WIDTH] > 32) ||
+		(checkpoint[CHECKPOINT_REFLECT_INPUT] > 1) || (checkpoint[CHECKPOINT_REFLECT_OUTPUT] > 1) )
+	{
+		return 0; // damaged, or not a checkpoint.
+	}
+
+	memset(&imported_state, 0, sizeof(imported_state));
+	imported_state.width = checkpoint[CHECKPOINT_WIDTH];
+	imported_state.reflect_input = checkpoint[CHECKPOINT_REFLECT_INPUT];
+	imported_state.reflect_output = checkpoint[CHECKPOINT_REFLECT_OUTPUT];
+	imported_state.polynomial = (uint32_t)_clbrzcrcx8_get_le(&checkpoint[CHECKPOINT_POLYNOMIAL], 4);
+	imported_state.initial_value = (uint32_t)_clbrzcrcx8_get_le(&checkpoint[CHECKPOINT_INITIAL_VALUE], 4);
+	imported_state.final_xor_value = (uint32_t)_clbrzcrcx8_get_le(&checkpoint[CHECKPOINT_FINAL_XOR_VALUE], 4);
+	imported_state.crc_register = (uint32_t)_clbrzcrcx8_get_le(&checkpoint[CHECKPOINT_REGISTER], 4);
+	imported_state.byte_count = _clbrzcrcx8_get_le(&checkpoint[CHECKPOINT_BYTE_COUNT], 8);
+
+	// resuming with another algorithm would give a wrong crc, quietly : refuse it.
+	if( (crc_configuration_ptr != NULL) &&
+		( (imported_state.width != crc_configuration_ptr->width) ||
+		  (imported_state.polynomial != (crc_configuration_ptr->polynomial & CRC_MASK(crc_configuration_ptr->width))) ||
+		  (imported_state.initial_value != (crc_configuration_ptr->initial_value & CRC_MASK(crc_configuration_ptr->width))) ||
+		  (imported_state.final_xor_value != crc_configuration_ptr->final_xor_value) ||
+		  (imported_state.reflect_input != crc_configuration_ptr->reflect_input) ||
+		  (imported_state.reflect_output != crc_configuration_ptr->reflect_output) ) )
+	{
+		return 0;
+	}
+
+	*crc_state_ptr = imported_state;
+	return 1; // ok.
+}
+
+
+// same algebra as combine, the register of the stream so far is already unfinalized.
+uint32_t clbrzcrcx8_append_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr, uint32_t range_crc, uint64_t range_length)
+{
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+
+	if(range_length == 0)
+	{
+		return crc_state_ptr->crc_register;
+	}
+
+	_clbrzcrcx8_state_to_descriptor(crc_state_ptr, &crc_configuration);
+	crc_state_ptr->crc_register = _clbrzcrcx8_multiply_mod_poly(crc_state_ptr->crc_register ^ crc_state_ptr->initial_value,
+										_clbrzcrcx8_x_pow_8n_mod_poly(range_length, crc_state_ptr->polynomial, crc_state_ptr->width),
+										crc_state_ptr->polynomial, crc_state_ptr->width)
+									^ _clbrzcrcx8_unfinalize(&crc_configuration, range_crc);
+	crc_state_ptr->byte_count += range_length;
+
+	return crc_state_ptr->crc_register;
+}
+
+
+
+// MULTI : several algorithms over the same data, in one pass. the data goes through in MULTI_BLOCK_SIZE blocks,
+// small enough to stay in L1 while every algorithm runs over it, so memory is read once, not once per algorithm.
+// within a block the table set lanes are interleaved word by word : the lookups of different algorithms do not
+// depend on each other, so their load latencies overlap instead of adding up.
+
+#define MULTI_BLOCK_SIZE		4096
+#define MULTI_MAX_LANES			8		// more states than that go through in groups, one pass per group
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+struct multi_lane
+{
+	const clbrzcrcx8_table_set_t* table_set;
+	uint32_t calculated_crc;				// as the engines keep it : reflected, or left-aligned to 32 bits
+	uint8_t table_kind;						// MULTI_TABLE_KIND()
+};
+
+#define MULTI_TABLE_KIND(table_set)		((uint8_t)((TABLE_ELEMENT_SIZE((table_set)->width) << 1) | (table_set)->reflected))
+
+#define MULTI_LANE_STEP(element_type, slicing_step)															\
+			{																								\
+				const element_type (*table)[256] = (const element_type (*)[256])lane->table_set->table;		\
+				const unsigned int table_shift = 32 - 8 * sizeof(element_type);								\
+																											\
+				(void)table_shift;																			\
+				slicing_step																				\
+			}
+
+static void _clbrzcrcx8_multi_interleave(struct multi_lane* lanes, size_t lane_count, const uint8_t* block, size_t block_len)
+{
+	size_t word_offset;
+	size_t lane_index;
+
+	for(word_offset = 0; word_offset < block_len; word_offset += CLBRZCRCX8_SLICING_DEPTH)
+	{
+		for(lane_index = 0; lane_index < lane_count; lane_index++)
+		{
+			struct multi_lane* lane = &lanes[lane_index];
+			const uint8_t* byte_data = block + word_offset;
+			uint32_t calculated_crc = lane->calculated_crc;
+
+			switch(lane->table_kind)
+			{
+				case (1 << 1) | 1:	MULTI_LANE_STEP(uint8_t, SLICING_STEP_REFLECTED)		break;
+				case (1 << 1):		MULTI_LANE_STEP(uint8_t, SLICING_STEP_NORMAL)			break;
+				case (2 << 1) | 1:	MULTI_LANE_STEP(uint16_t, SLICING_STEP_REFLECTED)		break;
+				case (2 << 1):		MULTI_LANE_STEP(uint16_t, SLICING_STEP_NORMAL)			break;
+				case (4 << 1) | 1:	MULTI_LANE_STEP(uint32_t, SLICING_STEP_REFLECTED)		break;
+				default:			MULTI_LANE_STEP(uint32_t, SLICING_STEP_NORMAL)			break;
+			}
+
+			lane->calculated_crc = calculated_crc;
+		}
+	}
+}
+
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+
+void clbrzcrcx8_update_crc_states(CLBRZCRCx8_CRCState_t* crc_states, size_t state_count, const void* data, size_t data_len)
+{
+	const uint8_t* byte_data = (const uint8_t*)data;
+	CLBRZCRCx8_CRCTypeDescriptor_t bitwise_configurations[MULTI_MAX_LANES];
+	CLBRZCRCx8_CRCState_t* bitwise_states[MULTI_MAX_LANES];
+	size_t bitwise_count = 0;
+	size_t head_len = 0;
+	size_t body_len = data_len;
+	size_t block_offset;
+	size_t block_len;
+	size_t state_index;
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	struct multi_lane lanes[MULTI_MAX_LANES];
+	CLBRZCRCx8_CRCState_t* lane_states[MULTI_MAX_LANES];
+	size_t lane_count = 0;
+	size_t lane_index;
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+	while(state_count > MULTI_MAX_LANES)
+	{
+		clbrzcrcx8_update_crc_states(crc_states, MULTI_MAX_LANES, data, data_len);
+		crc_states += MULTI_MAX_LANES;
+		state_count -= MULTI_MAX_LANES;
+	}
+
+	if((state_count == 0) || (data_len == 0))
+	{
+		return;
+	}
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	// the interleaved lanes step whole aligned words : the unaligned head and the short tail go through the single engines.
+	head_len = (size_t)(-(uintptr_t)byte_data & (CLBRZCRCX8_SLICING_DEPTH - 1));
+	head_len = (head_len < data_len) ? head_len : data_len;
+	body_len = (data_len - head_len) & ~(size_t)(CLBRZCRCX8_SLICING_DEPTH - 1);
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+	for(state_index = 0; state_index < state_count; state_index++)
+	{
+		clbrzcrcx8_update_crc_state(&crc_states[state_index], byte_data, head_len);
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		lanes[lane_count].table_set = _clbrzcrcx8_find_table_set(crc_states[state_index].polynomial,
+																crc_states[state_index].width,
+																crc_states[state_index].reflect_input);
+		if(lanes[lane_count].table_set != NULL)
+		{
+			if(lanes[lane_count].table_set->reflected == 1)
+			{
+				lanes[lane_count].calculated_crc = clbrzcrcx8_reflect(crc_states[state_index].crc_register, crc_states[state_index].width)
+													& CRC_MASK(crc_states[state_index].width);
+			}
+			else
+			{
+				lanes[lane_count].calculated_crc = crc_states[state_index].crc_register << (32 - crc_states[state_index].width);
+			}
+			lanes[lane_count].table_kind = MULTI_TABLE_KIND(lanes[lane_count].table_set);
+			lane_states[lane_count++] = &crc_states[state_index];
+			continue;
+		}
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+		_clbrzcrcx8_state_to_descriptor(&crc_states[state_index], &bitwise_configurations[bitwise_count]);
+		bitwise_states[bitwise_count++] = &crc_states[state_index];
+	}
+
+	for(block_offset = 0; block_offset < body_len; block_offset += block_len)
+	{
+		block_len = (body_len - block_offset < MULTI_BLOCK_SIZE) ? (body_len - block_offset) : MULTI_BLOCK_SIZE;
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		_clbrzcrcx8_multi_interleave(lanes, lane_count, byte_data + head_len + block_offset, block_len);
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+		for(state_index = 0; state_index < bitwise_count; state_index++)
+		{
+			bitwise_states[state_index]->crc_register = _clbrzcrcx8_update_bitwise(&bitwise_configurations[state_index],
+																					bitwise_states[state_index]->crc_register,
+																					byte_data + head_len + block_offset, block_len);
+		}
+	}
+
+	for(state_index = 0; state_index < bitwise_count; state_index++)
+	{
+		bitwise_states[state_index]->byte_count += body_len;
+	}
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	for(lane_index = 0; lane_index < lane_count; lane_index++)
+	{
+		if(lanes[lane_index].table_set->reflected == 1)
+		{
+			lane_states[lane_index]->crc_register = clbrzcrcx8_reflect(lanes[lane_index].calculated_crc, lane_states[lane_index]->width)
+													& CRC_MASK(lane_states[lane_index]->width);
+		}
+		else
+		{
+			lane_states[lane_index]->crc_register = lanes[lane_index].calculated_crc >> (32 - lane_states[lane_index]->width);
+		}
+		lane_states[lane_index]->byte_count += body_len;
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+	for(state_index = 0; state_index < state_count; state_index++)
+	{
+		clbrzcrcx8_update_crc_state(&crc_states[state_index], byte_data + head_len + body_len, data_len - head_len - body_len);
+	}
+}
+
+
+void clbrzcrcx8_calculate_crc_multi(const CLBRZCRCx8_CRCTypeDescriptor_t* const* crc_configurations,
+									uint32_t* crcs,
+									size_t algo_count,
+									const void* data,
+									size_t data_len)
+{
+	CLBRZCRCx8_CRCState_t crc_states[MULTI_MAX_LANES];
+	size_t group_start;
+	size_t group_size;
+	size_t state_index;
+
+	for(group_start = 0; group_start < algo_count; group_start += group_size)
+	{
+		group_size = (algo_count - group_start < MULTI_MAX_LANES) ? (algo_count - group_start) : MULTI_MAX_LANES;
+
+		for(state_index = 0; state_index < group_size; state_index++)
+		{
+			clbrzcrcx8_init_crc_state(&crc_states[state_index], crc_configurations[group_start + state_index]);
+		}
+
+		clbrzcrcx8_update_crc_states(crc_states, group_size, data, data_len);
+
+		for(state_index = 0; state_index < group_size; state_index++)
+		{
+			crcs[group_start + state_index] = clbrzcrcx8_finalize_crc_state(&crc_states[state_index]);
+		}
+	}
+}
+
+
+
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+// CALIBRATION : each engine is timed on every size class, in a few ms, and the fastest one per class becomes the plan.
+// the classes are powers of two, timed in their middle (1.5 * 2^n), so a threshold sits where the engines cross over.
+// every call on the same buffer is chained into the next, nothing can be optimized away and the lengths are all warm in L1.
+
+#include <time.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define CLBRZCRCX8_HAVE_CPU_BRAND
+#endif
+
+#define CALIBRATION_DATA_SIZE			(1 << (CLBRZCRCX8_CALIBRATION_SIZE_CLASSES - 1))	// the last class is timed at 8 KiB
+#define CALIBRATION_BYTES_PER_TRIAL		8192
+#define CALIBRATION_MIN_CALLS			4
+#define CALIBRATION_TRIALS				3		// best of
+#define CALIBRATION_MAX_LOSSES			2		// an engine slower than the winner on this many classes in a row is not timed any further
+
+// calibration file, little endian : magic "CLBRZCAL", version u32, host id u32, plan count u32,
+// per plan : poly u32, width, refin, engines[SIZE_CLASSES], then CRC-32C of all of the above u32.
+#define CALIBRATION_FILE_HEADER_SIZE	20
+#define CALIBRATION_FILE_PLAN_SIZE		(6 + CLBRZCRCX8_CALIBRATION_SIZE_CLASSES)
+#define CALIBRATION_FILE_MAX_SIZE		(CALIBRATION_FILE_HEADER_SIZE + CLBRZCRCX8_CALIBRATION_SLOTS * CALIBRATION_FILE_PLAN_SIZE + 4)
+#define CALIBRATION_FORMAT_VERSION		1
+
+static const uint8_t calibration_magic[8] = { 'C', 'L', 'B', 'R', 'Z', 'C', 'A', 'L' };
+
+
+static uint64_t _clbrzcrcx8_calibration_now_ns()
+{
+#if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0)
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#else
+	return (uint64_t)((double)clock() * (1e9 / CLOCKS_PER_SEC));
+#endif // #if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0)
+}
+
+
+// a plan is only good for the machine (and build) that timed it : the cpu model and the slicing depth go into the file.
+static uint32_t _clbrzcrcx8_calibration_host_id()
+{
+	uint8_t host_data[8 + 48] = { 0 };
+	size_t host_len = 8;
+#ifdef CLBRZCRCX8_HAVE_CPU_BRAND
+	unsigned int brand_words[12];
+	unsigned int leaf_index;
+
+	for (leaf_index = 0; leaf_index < 3; leaf_index++)
+	{
+		if(!__get_cpuid(0x80000002 + leaf_index, &brand_words[4 * leaf_index], &brand_words[4 * leaf_index + 1],
+												 &brand_words[4 * leaf_index + 2], &brand_words[4 * leaf_index + 3]))
+		{
+			break;
+		}
+	}
+	if(leaf_index == 3)
+	{
+		memcpy(&host_data[8], brand_words, sizeof(brand_words));
+		host_len += sizeof(brand_words);
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_CPU_BRAND
+
+	_clbrzcrcx8_put_le(&host_data[0], CALIBRATION_FORMAT_VERSION, 4);
+	_clbrzcrcx8_put_le(&host_data[4], CLBRZCRCX8_SLICING_DEPTH, 4);
+
+	return clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, host_data, host_len);
+}
+
+
+static size_t _clbrzcrcx8_calibration_class_len(unsigned int size_class)
+{
+	if(size_class == 0)
+	{
+		return 1;
+	}
+	if(size_class == CLBRZCRCX8_CALIBRATION_SIZE_CLASSES - 1)
+	{
+		return (size_t)1 << size_class;
+	}
+	return ((size_t)3 << size_class) / 2;
+}
+
+
+int clbrzcrcx8_calibrate(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, CLBRZCRCx8_CalibrationPlan_t* plan_ptr)
+{
+	const clbrzcrcx8_table_set_t* table_set;
+	CLBRZCRCx8_CalibrationPlan_t plan;
+	uint8_t calibration_data[CALIBRATION_DATA_SIZE];
+	uint8_t engine_losses[CALIBRATION_ENGINE_COUNT] = { 0 };
+	uint8_t engine_count;
+	uint8_t engine;
+	uint8_t best_engine;
+	unsigned int size_class;
+	unsigned int trial_index;
+	size_t call_count;
+	size_t call_index;
+	size_t data_len;
+	uint32_t random_state = 0x2545f491;
+	uint32_t reference_crc;
+	uint32_t calculated_crc;
+	uint64_t start_ns;
+	uint64_t elapsed_ns;
+	uint64_t engine_ns;
+	uint64_t best_ns;
+	volatile uint32_t crc_sink = 0;
+	size_t byte_index;
+
+	table_set = _clbrzcrcx8_find_table_set(crc_configuration_ptr->polynomial & CRC_MASK(crc_configuration_ptr->width),
+											crc_configuration_ptr->width,
+											crc_configuration_ptr->reflect_input);
+	if(table_set == NULL)
+	{
+		return 0; // no tables for it (cache full), nothing to pick from.
+	}
+
+	for (byte_index = 0; byte_index < sizeof(calibration_data); byte_index++)
+	{
+		random_state ^= random_state << 13;
+		random_state ^= random_state >> 17;
+		random_state ^= random_state << 5;
+		calibration_data[byte_index] = (uint8_t)random_state;
+	}
+
+	// with slicing-by-1 the slicing engine is the table engine.
+	engine_count = (CLBRZCRCX8_SLICING_DEPTH > 1) ? CALIBRATION_ENGINE_COUNT : CLBRZCRCX8_ENGINE_SLICING;
+
+	memset(&plan, 0, sizeof(plan));
+	plan.polynomial = table_set->polynomial;
+	plan.width = table_set->width;
+	plan.reflect_input = table_set->reflected;
+
+	for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+	{
+		data_len = _clbrzcrcx8_calibration_class_len(size_class);
+		call_count = CALIBRATION_BYTES_PER_TRIAL / data_len;
+		if(call_count < CALIBRATION_MIN_CALLS)
+		{
+			call_count = CALIBRATION_MIN_CALLS;
+		}
+
+		best_engine = engine_count - 1;
+		best_ns = UINT64_MAX;
+		reference_crc = 0;
+
+		for (engine = 0; engine < engine_count; engine++)
+		{
+			if(engine_losses[engine] >= CALIBRATION_MAX_LOSSES)
+			{
+				continue;
+			}
+
+			// warm up, and the crc every engine has to agree on.
+			calculated_crc = _clbrzcrcx8_run_engine(table_set, engine, 0, calibration_data, data_len);
+			if(best_ns == UINT64_MAX)
+			{
+				reference_crc = calculated_crc;	// first engine timed on this class
+			}
+			else if(calculated_crc != reference_crc)
+			{
+				return 0; // engines disagree : something is badly broken, do not plan with it.
+			}
+
+			engine_ns = UINT64_MAX;
+			for (trial_index = 0; trial_index < CALIBRATION_TRIALS; trial_index++)
+			{
+				start_ns = _clbrzcrcx8_calibration_now_ns();
+				for (call_index = 0; call_index < call_count; call_index++)
+				{
+					calculated_crc = _clbrzcrcx8_run_engine(table_set, engine, calculated_crc, calibration_data, data_len);
+				}
+				elapsed_ns = _clbrzcrcx8_calibration_now_ns() - start_ns;
+				crc_sink ^= calculated_crc;
+
+				if(elapsed_ns < engine_ns)
+				{
+					engine_ns = elapsed_ns;
+				}
+			}
+
+			// on a tie the later (more parallel) engine stays : it only gets better with length.
+			if(engine_ns <= best_ns)
+			{
+				best_ns = engine_ns;
+				best_engine = engine;
+			}
+		}
+
+		for (engine = 0; engine < engine_count; engine++)
+		{
+			if(engine == best_engine)
+			{
+				engine_losses[engine] = 0;
+			}
+			else if(engine < best_engine && engine_losses[engine] < CALIBRATION_MAX_LOSSES)
+			{
+				engine_losses[engine]++;
+			}
+		}
+
+		plan.engines[size_class] = best_engine;
+	}
+
+	(void)crc_sink;
+
+	if(!_clbrzcrcx8_store_plan(&plan))
+	{
+		return 0;
+	}
+
+	if(plan_ptr != NULL)
+	{
+		*plan_ptr = plan;
+	}
+
+	return 1;
+}
+
+
+int clbrzcrcx8_set_calibration(const CLBRZCRCx8_CalibrationPlan_t* plan_ptr)
+{
+	CLBRZCRCx8_CalibrationPlan_t plan = *plan_ptr;
+	unsigned int size_class;
+
+	if((plan.width < 8) || (plan.width > 32) || (plan.reflect_input > 1))
+	{
+		return 0;
+	}
+
+	for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+	{
+		if(plan.engines[size_class] >= CALIBRATION_ENGINE_COUNT)
+		{
+			return 0;
+		}
+	}
+
+	plan.polynomial &= CRC_MASK(plan.width);
+
+	return _clbrzcrcx8_store_plan(&plan);
+}
+
+
+int clbrzcrcx8_get_calibration(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, CLBRZCRCx8_CalibrationPlan_t* plan_ptr)
+{
+	struct calibration_slot* slot = _clbrzcrcx8_find_plan(crc_configuration_ptr->polynomial & CRC_MASK(crc_configuration_ptr->width),
+															crc_configuration_ptr->width,
+															crc_configuration_ptr->reflect_input);
+	unsigned int size_class;
+
+	if(slot == NULL)
+	{
+		return 0;
+	}
+
+	plan_ptr->polynomial = slot->polynomial;
+	plan_ptr->width = slot->width;
+	plan_ptr->reflect_input = slot->reflected;
+	for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+	{
+		plan_ptr->engines[size_class] = PLAN_ENGINE_LOAD(slot->engines[size_class]);
+	}
+
+	return 1;
+}
+
+
+int clbrzcrcx8_save_calibration(const char* path)
+{
+	uint8_t file_image[CALIBRATION_FILE_MAX_SIZE];
+	size_t file_len = CALIBRATION_FILE_HEADER_SIZE;
+	uint32_t plan_count = 0;
+	unsigned int slot_index;
+	unsigned int size_class;
+	struct calibration_slot* slot;
+	FILE* calibration_file;
+	int write_ok;
+
+	for (slot_index = 0; slot_index < CLBRZCRCX8_CALIBRATION_SLOTS; slot_index++)
+	{
+		slot = &calibration_slots[slot_index];
+		if(SLOT_STATE_LOAD(slot->state) != SLOT_READY)
+		{
+			continue;
+		}
+
+		_clbrzcrcx8_put_le(&file_image[file_len], slot->polynomial, 4);
+		file_image[file_len + 4] = slot->width;
+		file_image[file_len + 5] = slot->reflected;
+		for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+		{
+			file_image[file_len + 6 + size_class] = PLAN_ENGINE_LOAD(slot->engines[size_class]);
+		}
+		file_len += CALIBRATION_FILE_PLAN_SIZE;
+		plan_count++;
+	}
+
+	memcpy(&file_image[0], calibration_magic, sizeof(calibration_magic));
+	_clbrzcrcx8_put_le(&file_image[8], CALIBRATION_FORMAT_VERSION, 4);
+	_clbrzcrcx8_put_le(&file_image[12], _clbrzcrcx8_calibration_host_id(), 4);
+	_clbrzcrcx8_put_le(&file_image[16], plan_count, 4);
+	_clbrzcrcx8_put_le(&file_image[file_len], clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, file_image, file_len), 4);
+	file_len += 4;
+
+	calibration_file = fopen(path, "wb");
+	if(calibration_file == NULL)
+	{
+		return 0;
+	}
+
+	write_ok = (fwrite(file_image, 1, file_len, calibration_file) == file_len);
+	write_ok = (fclose(calibration_file) == 0) && write_ok;
+
+	return write_ok;
+}
+
+
+int clbrzcrcx8_load_calibration(const char* path)
+{
+	uint8_t file_image[CALIBRATION_FILE_MAX_SIZE + 1];
+	size_t file_len;
+	size_t plan_offset;
+	uint32_t plan_count;
+	uint32_t plan_index;
+	CLBRZCRCx8_CalibrationPlan_t plan;
+	FILE* calibration_file;
+	int load_ok = 1;
+
+	calibration_file = fopen(path, "rb");
+	if(calibration_file == NULL)
+	{
+		return 0; // not calibrated yet.
+	}
+
+	file_len = fread(file_image, 1, sizeof(file_image), calibration_file);
+	fclose(calibration_file);
+
+	if( (file_len < CALIBRATION_FILE_HEADER_SIZE + 4) ||
+		(memcmp(&file_image[0], calibration_magic, sizeof(calibration_magic)) != 0) ||
+		(_clbrzcrcx8_get_le(&file_image[8], 4) != CALIBRATION_FORMAT_VERSION) ||
+		(_clbrzcrcx8_get_le(&file_image[12], 4) != _clbrzcrcx8_calibration_host_id()) )
+	{
+		return 0; // not a calibration file, or timed on another machine : calibrate again.
+	}
+
+	plan_count = (uint32_t)_clbrzcrcx8_get_le(&file_image[16], 4);
+	if( (plan_count > CLBRZCRCX8_CALIBRATION_SLOTS) ||
+		(file_len != CALIBRATION_FILE_HEADER_SIZE + plan_count * CALIBRATION_FILE_PLAN_SIZE + 4) ||
+		(_clbrzcrcx8_get_le(&file_image[file_len - 4], 4) != clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, file_image, file_len - 4)) )
+	{
+		return 0; // damaged.
+	}
+
+	for (plan_index = 0; plan_index < plan_count; plan_index++)
+	{
+		plan_offset = CALIBRATION_FILE_HEADER_SIZE + plan_index * CALIBRATION_FILE_PLAN_SIZE;
+		plan.polynomial = (uint32_t)_clbrzcrcx8_get_le(&file_image[plan_offset], 4);
+		plan.width = file_image[plan_offset + 4];
+		plan.reflect_input = file_image[plan_offset + 5];
+		memcpy(plan.engines, &file_image[plan_offset + 6], CLBRZCRCX8_CALIBRATION_SIZE_CLASSES);
+
+		load_ok = clbrzcrcx8_set_calibration(&plan) && load_ok;
+	}
+
+	return load_ok;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+
+
+#ifdef CLBRZCRCX8_ENABLE_PARALLEL
+
+// PARALLEL : one large buffer cut into segments, a crc per segment on worker threads, the segment crcs combined in order.
+// NUMA (linux) : every segment is asked where its pages live (move_pages), and goes to a worker pinned to that node,
+// which runs on a node-local copy of the tables. a worker whose node has run out of segments helps the others,
+// so a badly placed buffer is slower, never stuck. one node (or no NUMA syscalls) : no pinning, no copies.
+
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#if defined(SYS_move_pages)
+#define CLBRZCRCX8_HAVE_NUMA
+#endif
+#endif // #if defined(__linux__)
+
+#ifndef CLBRZCRCX8_PARALLEL_MIN_SEGMENT
+#define CLBRZCRCX8_PARALLEL_MIN_SEGMENT	(1024 * 1024)	// smaller buffers are not worth a thread
+#endif // #ifndef CLBRZCRCX8_PARALLEL_MIN_SEGMENT
+
+#define PARALLEL_SEGMENTS_PER_THREAD	4				// some slack for uneven nodes and threads
+#define PARALLEL_MAX_THREADS			256
+#define PARALLEL_MAX_NODES				16
+#define PARALLEL_NODE_SAMPLES			8				// pages per segment asked for their node
+#define PARALLEL_PAGE_SIZE				4096
+
+struct parallel_segment
+{
+	const uint8_t* data;
+	size_t data_len;
+	uint32_t crc;
+	int node;
+	uint8_t taken;
+};
+
+struct parallel_context
+{
+	const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr;
+	struct parallel_segment* segments;
+	size_t segment_count;
+	int node_count;
+	pthread_mutex_t lock;							// segments taken, node table copies
+	size_t next_segment[PARALLEL_MAX_NODES];		// scan position per node
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	const clbrzcrcx8_table_set_t* table_set;
+	clbrzcrcx8_table_set_t node_table_sets[PARALLEL_MAX_NODES];
+	void* node_table_storage[PARALLEL_MAX_NODES];
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+};
+
+struct parallel_worker
+{
+	struct parallel_context* context;
+	int node;
+};
+
+
+#ifdef CLBRZCRCX8_HAVE_NUMA
+
+// where the nodes are described, the fuzz test points it at a fake tree with more nodes than the host has.
+static const char* parallel_node_dir = "/sys/devices/system/node";
+
+
+// "0-3,8,10-11" (sysfs cpulist/nodelist format) -> callback per number.
+static void _clbrzcrcx8_parallel_parse_list(const char* path, void (*add)(void*, int), void* add_arg)
+{
+	char list[1024];
+	char* cursor;
+	long first;
+	long last;
+	FILE* list_file = fopen(path, "r");
+
+	if(list_file == NULL)
+	{
+		return;
+	}
+	if(fgets(list, sizeof(list), list_file) != NULL)
+	{
+		cursor = list;
+		while((*cursor >= '0') && (*cursor <= '9'))
+		{
+			first = strtol(cursor, &cursor, 10);
+			last = (*cursor == '-') ? strtol(cursor + 1, &cursor, 10) : first;
+			for (; first <= last; first++)
+			{
+				add(add_arg, (int)first);
+			}
+			if(*cursor == ',')
+			{
+				cursor++;
+			}
+		}
+	}
+	fclose(list_file);
+}
+
+
+static void _clbrzcrcx8_parallel_add_node(void* node_count_ptr, int node)
+{
+	if((node < PARALLEL_MAX_NODES) && (node + 1 > *(int*)node_count_ptr))
+	{
+		*(int*)node_count_ptr = node + 1;
+	}
+}
+
+
+static void _clbrzcrcx8_parallel_add_cpu(void* cpu_set_ptr, int cpu)
+{
+	if(cpu < CPU_SETSIZE)
+	{
+		CPU_SET(cpu, (cpu_set_t*)cpu_set_ptr);
+	}
+}
+
+
+// the node most of the sampled (already faulted in) pages of a segment are on, -1 if the kernel does not say.
+static int _clbrzcrcx8_parallel_segment_node(const struct parallel_segment* segment)
+{
+	void* pages[PARALLEL_NODE_SAMPLES];
+	int page_nodes[PARALLEL_NODE_SAMPLES];
+	int node_pages[PARALLEL_MAX_NODES] = {0};
+	int sample_index;
+	int node;
+	int best_node = -1;
+
+	for (sample_index = 0; sample_index < PARALLEL_NODE_SAMPLES; sample_index++)
+	{
+		pages[sample_index] = (void*)((uintptr_t)(segment->data + segment->data_len * sample_index / PARALLEL_NODE_SAMPLES)
+										& ~(uintptr_t)(PARALLEL_PAGE_SIZE - 1));
+	}
+
+	// no target nodes : only asks, moves nothing.
+	if(syscall(SYS_move_pages, 0, (unsigned long)PARALLEL_NODE_SAMPLES, pages, NULL, page_nodes, 0) != 0)
+	{
+		return -1;
+	}
+
+	for (sample_index = 0; sample_index < PARALLEL_NODE_SAMPLES; sample_index++)
+	{
+		node = page_nodes[sample_index];
+		if((node >= 0) && (node < PARALLEL_MAX_NODES) && (++node_pages[node] > ((best_node < 0) ? 0 : node_pages[best_node])))
+		{
+			best_node = node;
+		}
+	}
+
+	return best_node;
+}
+
+#endif // #ifdef CLBRZCRCX8_HAVE_NUMA
+
+
+// next segment for a worker of this node : its own node's first, then anyone's.
+static struct parallel_segment* _clbrzcrcx8_parallel_take(struct parallel_context* context, int node)
+{
+	struct parallel_segment* segment = NULL;
+	size_t segment_index;
+
+	pthread_mutex_lock(&context->lock);
+	for (segment_index = context->next_segment[node]; segment_index < context->segment_count; segment_index++)
+	{
+		if(!context->segments[segment_index].taken && (context->segments[segment_index].node == node))
+		{
+			segment = &context->segments[segment_index];
+			break;
+		}
+	}
+	context->next_segment[node] = segment_index;
+	for (segment_index = 0; (segment == NULL) && (segment_index < context->segment_count); segment_index++)
+	{
+		if(!context->segments[segment_index].taken)
+		{
+			segment = &context->segments[segment_index];
+		}
+	}
+	if(segment != NULL)
+	{
+		segment->taken = 1;
+	}
+	pthread_mutex_unlock(&context->lock);
+
+	return segment;
+}
+
+
+static void* _clbrzcrcx8_parallel_worker(void* worker_arg)
+{
+	struct parallel_worker* worker = (struct parallel_worker*)worker_arg;
+	struct parallel_context* context = worker->context;
+	const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr = context->crc_configuration_ptr;
+	struct parallel_segment* segment;
+	uint32_t calculated_crc;
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	const clbrzcrcx8_table_set_t* table_set = context->table_set;
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+#ifdef CLBRZCRCX8_HAVE_NUMA
+	cpu_set_t previous_cpus;
+	int pinned = 0;
+#endif // #ifdef CLBRZCRCX8_HAVE_NUMA
+
+#ifdef CLBRZCRCX8_HAVE_NUMA
+	if(context->node_count > 1)
+	{
+		char path[256];
+		cpu_set_t node_cpus;
+
+		// pinned first, so the table copy below is first touched, and so placed, on this node.
+		// the last worker runs on the caller's thread : its affinity is put back before returning.
+		CPU_ZERO(&node_cpus);
+		snprintf(path, sizeof(path), "%s/node%d/cpulist", parallel_node_dir, worker->node);
+		_clbrzcrcx8_parallel_parse_list(path, _clbrzcrcx8_parallel_add_cpu, &node_cpus);
+		if( (CPU_COUNT(&node_cpus) > 0) &&
+			(pthread_getaffinity_np(pthread_self(), sizeof(previous_cpus), &previous_cpus) == 0) )
+		{
+			pinned = (pthread_setaffinity_np(pthread_self(), sizeof(node_cpus), &node_cpus) == 0);
+		}
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		if(table_set != NULL)
+		{
+			pthread_mutex_lock(&context->lock);
+			if(context->node_table_storage[worker->node] == NULL)
+			{
+				context->node_table_storage[worker->node] = malloc(TABLE_SET_STORAGE_SIZE(table_set->width));
+				if(context->node_table_storage[worker->node] != NULL)
+				{
+					memcpy(context->node_table_storage[worker->node], table_set->table, TABLE_SET_STORAGE_SIZE(table_set->width));
+					context->node_table_sets[worker->node] = *table_set;
+					context->node_table_sets[worker->node].table = context->node_table_storage[worker->node];
+				}
+			}
+			if(context->node_table_storage[worker->node] != NULL)
+			{
+				table_set = &context->node_table_sets[worker->node];
+			}
+			pthread_mutex_unlock(&context->lock);
+		}
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_NUMA
+
+	while((segment = _clbrzcrcx8_parallel_take(context, worker->node)) != NULL)
+	{
+		calculated_crc = crc_configuration_ptr->initial_value & CRC_MASK(crc_configuration_ptr->width);
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		if(table_set != NULL)
+		{
+			calculated_crc = _clbrzcrcx8_update_table_set(table_set, calculated_crc, segment->data, segment->data_len);
+		}
+		else
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		{
+			calculated_crc = _clbrzcrcx8_update_bitwise(crc_configuration_ptr, calculated_crc, segment->data, segment->data_len);
+		}
+		segment->crc = _clbrzcrcx8_finalize(crc_configuration_ptr, calculated_crc);
+	}
+
+#ifdef CLBRZCRCX8_HAVE_NUMA
+	if(pinned)
+	{
+		pthread_setaffinity_np(pthread_self(), sizeof(previous_cpus), &previous_cpus);
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_NUMA
+
+	return NULL;
+}
+
+
+uint32_t clbrzcrcx8_calculate_crc_parallel(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+											const void* data,
+											size_t data_len,
+											unsigned int thread_count)
+{
+	const uint8_t* byte_data = (const uint8_t*)data;
+	struct parallel_context context;
+	struct parallel_worker workers[PARALLEL_MAX_THREADS];
+	pthread_t threads[PARALLEL_MAX_THREADS];
+	unsigned char thread_started[PARALLEL_MAX_THREADS] = {0};
+	size_t node_bytes[PARALLEL_MAX_NODES] = {0};
+	size_t segment_size;
+	size_t segment_index;
+	uintptr_t segment_start;
+	uintptr_t segment_end;
+	uintptr_t cut;
+	unsigned int thread_index;
+	unsigned int node_threads[PARALLEL_MAX_NODES] = {0};
+	int node;
+	uint32_t crc;
+
+	if(thread_count == 0)
+	{
+		long online_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		thread_count = (online_cpus > 0) ? (unsigned int)online_cpus : 1;
+	}
+	if(thread_count > PARALLEL_MAX_THREADS)
+	{
+		thread_count = PARALLEL_MAX_THREADS;
+	}
+	if(thread_count > data_len / CLBRZCRCX8_PARALLEL_MIN_SEGMENT)
+	{
+		thread_count = (unsigned int)(data_len / CLBRZCRCX8_PARALLEL_MIN_SEGMENT);
+	}
+	if(thread_count <= 1)
+	{
+		return clbrzcrcx8_calculate_crc(crc_configuration_ptr, data, data_len);
+	}
+
+	segment_size = data_len / ((size_t)thread_count * PARALLEL_SEGMENTS_PER_THREAD);
+	segment_size = (segment_size < CLBRZCRCX8_PARALLEL_MIN_SEGMENT) ? CLBRZCRCX8_PARALLEL_MIN_SEGMENT : segment_size;
+
+	memset(&context, 0, sizeof(context));
+	context.crc_configuration_ptr = crc_configuration_ptr;
+	context.segment_count = (data_len + segment_size - 1) / segment_size;
+	context.segments = (struct parallel_segment*)calloc(context.segment_count, sizeof(struct parallel_segment));
+	context.node_count = 1;
+	if(context.segments == NULL)
+	{
+		return clbrzcrcx8_calculate_crc(crc_configuration_ptr, data, data_len);
+	}
+	pthread_mutex_init(&context.lock, NULL);
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	context.table_set = _clbrzcrcx8_find_table_set(crc_configuration_ptr->polynomial, crc_configuration_ptr->width, crc_configuration_ptr->reflect_input);
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+#ifdef CLBRZCRCX8_HAVE_NUMA
+	{
+		char path[256];
+
+		snprintf(path, sizeof(path), "%s/online", parallel_node_dir);
+		_clbrzcrcx8_parallel_parse_list(path, _clbrzcrcx8_parallel_add_node, &context.node_count);
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_NUMA
+
+	// the cuts are on page boundaries of the address space, the buffer itself need not be page aligned :
+	// so a page belongs to one segment only, the first and the last segments take the unaligned ends.
+	// a cut rounded up past the end leaves empty segments at the tail, they are dropped.
+	segment_start = (uintptr_t)byte_data;
+	for (segment_index = 0; segment_index < context.segment_count; segment_index++)
+	{
+		segment_end = (uintptr_t)byte_data + data_len;
+		if(segment_index + 1 < context.segment_count)
+		{
+			cut = ((uintptr_t)byte_data + (segment_index + 1) * segment_size + PARALLEL_PAGE_SIZE - 1) & ~(uintptr_t)(PARALLEL_PAGE_SIZE - 1);
+			segment_end = (cut < segment_end) ? cut : segment_end;
+		}
+		context.segments[segment_index].data = (const uint8_t*)segment_start;
+		context.segments[segment_index].data_len = (size_t)(segment_end - segment_start);
+		segment_start = segment_end;
+	}
+	while((context.segment_count > 1) && (context.segments[context.segment_count - 1].data_len == 0))
+	{
+		context.segment_count--;
+	}
+
+	for (segment_index = 0; segment_index < context.segment_count; segment_index++)
+	{
+#ifdef CLBRZCRCX8_HAVE_NUMA
+		if(context.node_count > 1)
+		{
+			node = _clbrzcrcx8_parallel_segment_node(&context.segments[segment_index]);
+			context.segments[segment_index].node = (node < 0) ? 0 : node;	// not faulted in yet : anyone's, node 0 starts on it
+		}
+#endif // #ifdef CLBRZCRCX8_HAVE_NUMA
+		node_bytes[context.segments[segment_index].node] += context.segments[segment_index].data_len;
+	}
+
+	// threads per node in proportion to the bytes on the node : each next thread goes to the node with the most bytes per thread.
+	for (thread_index = 0; thread_index < thread_count; thread_index++)
+	{
+		int best_node = 0;
+
+		for (node = 1; node < context.node_count; node++)
+		{
+			if((double)node_bytes[node] / (node_threads[node] + 1) > (double)node_bytes[best_node] / (node_threads[best_node] + 1))
+			{
+				best_node = node;
+			}
+		}
+		node_threads[best_node]++;
+		workers[thread_index].context = &context;
+		workers[thread_index].node = best_node;
+	}
+
+	// the last worker runs in this thread, and so does any worker that could not get a thread of its own.
+	for (thread_index = 0; thread_index < thread_count; thread_index++)
+	{
+		if(thread_index + 1 < thread_count)
+		{
+			thread_started[thread_index] = (pthread_create(&threads[thread_index], NULL, _clbrzcrcx8_parallel_worker, &workers[thread_index]) == 0);
+		}
+		if(!thread_started[thread_index])
+		{
+			_clbrzcrcx8_parallel_worker(&workers[thread_index]);
+		}
+	}
+	for (thread_index = 0; thread_index < thread_count; thread_index++)
+	{
+		if(thread_started[thread_index])
+		{
+			pthread_join(threads[thread_index], NULL);
+		}
+	}
+
+	crc = context.segments[0].crc;
+	for (segment_index = 1; segment_index < context.segment_count; segment_index++)
+	{
+		crc = clbrzcrcx8_combine_crc(crc_configuration_ptr, crc, context.segments[segment_index].crc, context.segments[segment_index].data_len);
+	}
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	for (node = 0; node < PARALLEL_MAX_NODES; node++)
+	{
+		free(context.node_table_storage[node]);
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	pthread_mutex_destroy(&context.lock);
+	free(context.segments);
+
+	return crc;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_PARALLEL
+
+
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+void clbrzcrcx8_generate_crc_table()
+{
+	_clbrzcrcx8_generate_crc_table(current_crc_info.crc_configuration.polynomial,
+						current_crc_info.crc_configuration.width);
+}
+
+void clbrzcrcx8_print_crc_table()
+{
+	// init_crc() no longer regenerates this table (it uses the shared table cache), so do it here.
+	clbrzcrcx8_generate_crc_table();
+	_clbrzcrcx8_print_crc_table(current_crc_info.crc_configuration.width);
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
+uint32_t clbrzcrcx8_calculate_self_residue()
+{
+	// WORK IN PROGRESS, does not work as expected with refin=refout=true!
+	uint32_t calculated_crc;
+	//uint32_t residue[3];
+	uint8_t _data [14];
+	uint8_t crc_width_bytes = current_crc_info.crc_configuration.width/8;
+
+	memcpy(_data, (uint8_t*)"123456789", 9);
+	clbrzcrcx8_reset_crc_chunk();
+	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	clbrzcrcx8_reset_crc_chunk();
+	if(current_crc_info.crc_configuration.reflect_input == 0 &&
+			current_crc_info.crc_configuration.reflect_output == 0 )
+	{
+		//calculated_crc = 0;
+	}
+	memcpy(_data + 9, (uint8_t*)&calculated_crc,  crc_width_bytes);
+	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9 + crc_width_bytes);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	clbrzcrcx8_reset_crc_chunk();
+
+	printf("residue: 0x%08x\n\n",calculated_crc);
+
+
+
+	memcpy(_data, (uint8_t*)"987654321", 9);
+	clbrzcrcx8_reset_crc_chunk();
+	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	clbrzcrcx8_reset_crc_chunk();
+	if(current_crc_info.crc_configuration.reflect_input == 0 &&
+			current_crc_info.crc_configuration.reflect_output == 0 )
+	{
+		//calculated_crc = 0;
+	}
+	memcpy(_data + 9, (uint8_t*)&calculated_crc,  crc_width_bytes);
+	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9 + crc_width_bytes);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	clbrzcrcx8_reset_crc_chunk();
+
+	printf("residue: 0x%08x\n\n",calculated_crc);
+
+
+
+	memcpy(_data, (uint8_t*)"123123123", 9);
+	clbrzcrcx8_reset_crc_chunk();
+	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	clbrzcrcx8_reset_crc_chunk();
+	if(current_crc_info.crc_configuration.reflect_input == 0 &&
+			current_crc_info.crc_configuration.reflect_output == 0 )
+	{
+		//calculated_crc = 0;
+	}
+	memcpy(_data + 9, (uint8_t*)&calculated_crc,  crc_width_bytes);
+	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,9 + crc_width_bytes);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	clbrzcrcx8_reset_crc_chunk();
+
+	printf("residue: 0x%08x\n\n",calculated_crc);
+
+
+
+	memcpy(_data, (uint8_t*)"123123123123", 12);
+	clbrzcrcx8_reset_crc_chunk();
+	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,12);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	clbrzcrcx8_reset_crc_chunk();
+	if(current_crc_info.crc_configuration.reflect_input == 0 &&
+			current_crc_info.crc_configuration.reflect_output == 0 )
+	{
+		//calculated_crc = 0;
+	}
+	memcpy(_data + 12, (uint8_t*)&calculated_crc,  crc_width_bytes);
+	calculated_crc = clbrzcrcx8_calculate_crc_chunk(_data,12 + crc_width_bytes);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	clbrzcrcx8_reset_crc_chunk();
+
+	printf("residue: 0x%08x\n\n",calculated_crc);
+
+	//NOTE: residue is reflected in our algo compared to reveng catalogue.
+
+	return 0;
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
+
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
+// init_crc() must be called with valid configuration and valid check value before this !
+int clbrzcrcx8_self_test()
+{
+	uint32_t calculated_crc;
+	uint64_t aligned_data[3];		// check string at every offset in a word, so the unaligned head/tail paths run too.
+	size_t data_offset;
+	// assumed that the user has set proper configuration using init_crc, including the check value.
+	// the CRC algorithm is run over the string : "123456789\0" and calculated crc should be the check value.
+	// if not, then the crc implementation has a problem with the particular configuration or the check value is wrong.
+	// this is more of a sanity test to check that the crc works ok, and not meant to be used for anything else.
+	clbrzcrcx8_reset_crc_chunk();
+	calculated_crc = clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	clbrzcrcx8_reset_crc_chunk();
+
+	if(calculated_crc != current_crc_info.crc_configuration.check_value)
+	{
+		//printf("\n%-20s : self-test failed.\n", current_crc_info.crc_configuration.crc_algo_name);
+		return 0; // failed self test
+	}
+
+	for(data_offset = 0; data_offset < sizeof(uint64_t); data_offset++)
+	{
+		memcpy((uint8_t*)aligned_data + data_offset, "123456789", 9);
+		clbrzcrcx8_calculate_crc_buffer((const uint8_t*)aligned_data + data_offset, 9);
+		calculated_crc = clbrzcrcx8_finalize_crc();
+		clbrzcrcx8_reset_crc_chunk();
+
+		if(calculated_crc != current_crc_info.crc_configuration.check_value)
+		{
+			return 0; // failed self test
+		}
+	}
+
+	//printf("\n%-20s : self-test ok.\n", current_crc_info.crc_configuration.crc_algo_name);
+	return 1; // ok
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
+
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_TEST
+int clbrzcrcx8_check_crc_8_algo()
+{
+	uint8_t calculated_crc;
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+
+	// CRC-8 : width=8 poly=0x07 init=0x00 refin=false refout=false xorout=0x00 check=0xf4 name="CRC-8"
+	crc_configuration.name = "CRC-8";					// optional
+	crc_configuration.width = 8;
+	crc_configuration.polynomial = 0x07;
+	crc_configuration.initial_value = 0x00;
+	crc_configuration.final_xor_value = 0x00;
+	crc_configuration.reflect_input = 0;
+	crc_configuration.reflect_output = 0;
+	crc_configuration.check_value = 0xf4;						// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x00;							// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+
+	calculated_crc = (uint8_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint8_t)clbrzcrcx8_finalize_crc();
+	//print_crc_table();
+
+	if(0xf4 != calculated_crc)
+	{
+		printf ("CRC-8 reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-8 check passed.\n\n");
+	}
+
+
+	// CRC-8/CDMA2000 : width=8 poly=0x9b init=0xff refin=false refout=false xorout=0x00 check=0xda name="CRC-8/CDMA2000"
+	crc_configuration.name = "CRC-8/CDMA2000";					// optional
+	crc_configuration.width = 8;
+	crc_configuration.polynomial = 0x9b;
+	crc_configuration.initial_value = 0xff;
+	crc_configuration.final_xor_value = 0x00;
+	crc_configuration.reflect_input = 0;
+	crc_configuration.reflect_output = 0;
+	crc_configuration.check_value = 0xda;								// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x00;							// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+	calculated_crc = (uint8_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint8_t)clbrzcrcx8_finalize_crc();
+
+	if(0xda != calculated_crc)
+	{
+		printf ("CRC-8/CDMA2000 reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-8/CDMA2000 check passed.\n\n");
+	}
+
+
+	// CRC-8/ITU : width=8 poly=0x07 init=0x00 refin=false refout=false xorout=0x55 check=0xa1 name="CRC-8/ITU"
+	crc_configuration.name = "CRC-8/ITU";						// optional
+	crc_configuration.width = 8;
+	crc_configuration.polynomial = 0x07;
+	crc_configuration.initial_value = 0x00;
+	crc_configuration.final_xor_value = 0x55;
+	crc_configuration.reflect_input = 0;
+	crc_configuration.reflect_output = 0;
+	crc_configuration.check_value = 0xa1;								// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x00;									// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+	calculated_crc = (uint8_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint8_t)clbrzcrcx8_finalize_crc();
+
+	if(0xa1 != calculated_crc)
+	{
+		printf ("CRC-8/ITU reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-8/ITU check passed.\n\n");
+	}
+
+
+	// CRC-8/DARC : width=8 poly=0x39 init=0x00 refin=true refout=true xorout=0x00 check=0x15 name="CRC-8/DARC"
+	crc_configuration.name = "CRC-8/DARC";						// optional
+	crc_configuration.width = 8;
+	crc_configuration.polynomial = 0x39;
+	crc_configuration.initial_value = 0x00;
+	crc_configuration.final_xor_value = 0x00;
+	crc_configuration.reflect_input = 1;
+	crc_configuration.reflect_output = 1;
+	crc_configuration.check_value = 0x15;								// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x00;							// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+	clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint8_t)clbrzcrcx8_finalize_crc();
+
+	if(0x15 != calculated_crc)
+	{
+		printf ("CRC-8/DARC reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-8/DARC check passed.\n\n");
+	}
+
+
+	return 1; // ok.
+}
+
+
+int clbrzcrcx8_check_crc_16_algo()
+{
+	uint16_t calculated_crc;
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+
+	// CRC-16/AUG-CCITT : width=16 poly=0x1021 init=0x1d0f refin=false refout=false xorout=0x0000 check=0xe5cc name="CRC-16/AUG-CCITT"
+	crc_configuration.name = "CRC-16/AUG-CCITT";			// optional
+	crc_configuration.width = 16;
+	crc_configuration.polynomial = 0x1021;
+	crc_configuration.initial_value = 0x1d0f;
+	crc_configuration.final_xor_value = 0x0000;
+	crc_configuration.reflect_input = 0;
+	crc_configuration.reflect_output = 0;
+	crc_configuration.check_value = 0xe5cc;							// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x0000;								// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+	calculated_crc = (uint16_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint16_t)clbrzcrcx8_finalize_crc();
+	//print_crc_table();
+
+	if(0xe5cc != calculated_crc)
+	{
+		printf ("CRC-16/AUG-CCITT reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-16/AUG-CCITT check passed.\n\n");
+	}
+
+
+	// CRC-16/CCITT-FALSE: width=16 poly=0x1021 init=0xffff refin=false refout=false xorout=0x0000 check=0x29b1 name="CRC-16/CCITT-FALSE"
+	crc_configuration.name = "CRC-16/CCITT-FALSE";			// optional
+	crc_configuration.width = 16;
+	crc_configuration.polynomial = 0x1021;
+	crc_configuration.initial_value = 0xffff;
+	crc_configuration.final_xor_value = 0x0000;
+	crc_configuration.reflect_input = 0;
+	crc_configuration.reflect_output = 0;
+	crc_configuration.check_value = 0x29b1;							// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x0000;								// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+	calculated_crc = (uint16_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint16_t)clbrzcrcx8_finalize_crc();
+
+	if(0x29b1 != calculated_crc)
+	{
+		printf ("CRC-16/CCITT-FALSE reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-16/CCITT-FALSE check passed.\n\n");
+	}
+
+
+	// CRC-16/ARC : width=16 poly=0x8005 init=0x0000 refin=true refout=true xorout=0x0000 check=0xbb3d name="ARC"
+	crc_configuration.name = "CRC-16/ARC";					// optional
+	crc_configuration.width = 16;
+	crc_configuration.polynomial = 0x8005;
+	crc_configuration.initial_value = 0x0000;
+	crc_configuration.final_xor_value = 0x0000;
+	crc_configuration.reflect_input = 1;
+	crc_configuration.reflect_output = 1;
+	crc_configuration.check_value = 0xbb3d;							// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x0000;								// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+	calculated_crc = (uint16_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint16_t)clbrzcrcx8_finalize_crc();
+
+	if(0xbb3d != calculated_crc)
+	{
+		printf ("CRC-16/ARC reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-16/ARC check passed.\n\n");
+	}
+
+
+	return 1; // ok.
+}
+
+
+int clbrzcrcx8_check_crc_32_algo()
+{
+	uint32_t calculated_crc;
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+
+	// CRC-32/BZIP2 : width=32 poly=0x04c11db7 init=0xffffffff refin=false refout=false xorout=0xffffffff check=0xfc891918 name="CRC-32/BZIP2"
+	crc_configuration.name = "CRC-32/BZIP2";					// optional
+	crc_configuration.width = 32;
+	crc_configuration.polynomial = 0x04c11db7;
+	crc_configuration.initial_value = 0xffffffff;
+	crc_configuration.final_xor_value = 0xffffffff;
+	crc_configuration.reflect_input = 0;
+	crc_configuration.reflect_output = 0;
+	crc_configuration.check_value = 0xfc891918;							// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x00000000;								// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+	calculated_crc = (uint32_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint32_t)clbrzcrcx8_finalize_crc();
+
+	if(0xfc891918 != calculated_crc)
+	{
+		printf ("CRC-32/BZIP2 reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-32/BZIP2 check passed.\n\n");
+	}
+
+	// CRC-32 : width=32 poly=0x04c11db7 init=0xffffffff refin=true refout=true xorout=0xffffffff check=0xcbf43926 name="CRC-32"
+	crc_configuration.name = "CRC-32";					// optional
+	crc_configuration.width = 32;
+	crc_configuration.polynomial = 0x04c11db7;
+	crc_configuration.initial_value = 0xffffffff;
+	crc_configuration.final_xor_value = 0xffffffff;
+	crc_configuration.reflect_input = 1;
+	crc_configuration.reflect_output = 1;
+	crc_configuration.check_value = 0xcbf43926;						// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x00000000;							// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+	calculated_crc = (uint32_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint32_t)clbrzcrcx8_finalize_crc();
+	//print_crc_table();
+
+	if(0xcbf43926 != calculated_crc)
+	{
+		printf ("CRC-32 reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-32 check passed.\n\n");
+	}
+
+
+	// CRC-32C : width=32 poly=0x1edc6f41 init=0xffffffff refin=true refout=true xorout=0xffffffff check=0xe3069283 name="CRC-32C"
+	crc_configuration.name = "CRC-32C";					// optional
+	crc_configuration.width = 32;
+	crc_configuration.polynomial = 0x1edc6f41;
+	crc_configuration.initial_value = 0xffffffff;
+	crc_configuration.final_xor_value = 0xffffffff;
+	crc_configuration.reflect_input = 1;
+	crc_configuration.reflect_output = 1;
+	crc_configuration.check_value = 0xe3069283;						// optional, check = CRC of string "123456789\0"
+	crc_configuration.residue = 0x00000000;							// optional, residue = CRC (DATA + CRC)
+	clbrzcrcx8_init_crc(&crc_configuration);
+	calculated_crc = (uint32_t)clbrzcrcx8_calculate_crc_chunk((uint8_t*)"123456789",9);
+	calculated_crc = (uint32_t)clbrzcrcx8_finalize_crc();
+
+	if(0xe3069283 != calculated_crc)
+	{
+		printf ("CRC-32C reference check failed!\n\n");
+		return -1;
+	}
+	else
+	{
+		printf ("CRC-32C check passed.\n\n");
+	}
+
+
+	return 1; // ok.
+}
+
+
+int clbrzcrcx8_check_reflect()
+{
+	uint8_t source_bytes[100];
+	uint8_t reflected_bytes[100];
+	uint32_t value = 0x3e23;
+	int num_bits;
+	int byte_index;
+	int round;
+
+	printf("reflect(0x3e23,3) : 0x%x\n", clbrzcrcx8_reflect(0x3e23, 3));
+	if(clbrzcrcx8_reflect(0x3e23, 3) != 0x3e26)
+	{
+		return 0;
+	}
+
+	// the fast reflect against the bitwise loop, every bit count and a spread of values.
+	for (round = 0; round < 64; round++)
+	{
+		for (num_bits = 0; num_bits <= 48; num_bits++)
+		{
+			if(clbrzcrcx8_reflect(value, (uint8_t)num_bits) != _clbrzcrcx8_reflect_bitwise(value, (uint8_t)num_bits))
+			{
+				printf("reflect(0x%08x,%d) mismatch\n", (unsigned int)value, num_bits);
+				return 0;
+			}
+		}
+		value = value * 1664525UL + 1013904223UL;
+	}
+
+	// bulk reflect : odd length so both the SIMD body and the byte tail run, then in place and back.
+	for (byte_index = 0; byte_index < 100; byte_index++)
+	{
+		source_bytes[byte_index] = (uint8_t)(byte_index * 37 + 11);
+	}
+	clbrzcrcx8_reflect_buffer(reflected_bytes, source_bytes, sizeof(reflected_bytes));
+	for (byte_index = 0; byte_index < 100; byte_index++)
+	{
+		if(reflected_bytes[byte_index] != _clbrzcrcx8_reflect_bitwise(source_bytes[byte_index], 8))
+		{
+			printf("reflect_buffer mismatch at %d\n", byte_index);
+			return 0;
+		}
+	}
+	clbrzcrcx8_reflect_buffer(reflected_bytes, reflected_bytes, sizeof(reflected_bytes));
+	if(memcmp(reflected_bytes, source_bytes, sizeof(source_bytes)) != 0)
+	{
+		printf("reflect_buffer in place mismatch\n");
+		return 0;
+	}
+
+	return 1; // ok.
+}
+
+
+int clbrzcrcx8_test()
+{
+	puts("\ncrickey! test crc algo for 8,16,32 bit crcs >>\n"); // prints crickey!
+
+
+	// self-check:
+	printf("\n---------------------------------------\n");
+	if( clbrzcrcx8_check_crc_8_algo() == 1)
+	{
+		printf(">> CRC-8 ok. <<\n");
+	}
+	else
+	{
+		printf(">> CRC-8 test failed. <<\n");
+		return -1;
+	}
+	printf("---------------------------------------\n\n");
+
+	printf("\n---------------------------------------\n");
+	if( clbrzcrcx8_check_crc_16_algo() == 1)
+	{
+		printf(">> CRC-16 ok. <<\n");
+	}
+	else
+	{
+		printf(">> CRC-16 test failed. <<\n");
+		return -1;
+	}
+	printf("---------------------------------------\n\n");
+
+	printf("\n---------------------------------------\n");
+	if( clbrzcrcx8_check_reflect() == 1)
+	{
+		printf(">> reflect ok. <<\n");
+	}
+	else
+	{
+		printf(">> reflect test failed. <<\n");
+		return -1;
+	}
+	printf("---------------------------------------\n\n");
+
+	printf("\n---------------------------------------\n");
+	if( clbrzcrcx8_check_crc_32_algo() == 1)
+	{
+		printf(">> CRC-32 ok. <<\n");
+	}
+	else
+	{
+		printf(">> CRC-32 test failed. <<\n");
+		return -1;
+	}
+	printf("---------------------------------------\n\n");
+
+
+	return 1;
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_TEST
+
+// TODO add further configurations from <reveng>
+CLBRZCRCx8_CRCTypeDescriptor_t clbrzcrcx8_crc_algo_list[] =
+{
+//		  name						width	poly		init		xor			refin	refout	check
+		{ "CRC-8",					8, 		0x00000007, 0x00000000, 0x00000000, 0, 		0, 		0x000000f4 },
+		{ "CRC-8/AUTOSAR",			8, 		0x0000002f, 0x000000ff, 0x000000ff, 0, 		0, 		0x000000df },
+		{ "CRC-8/BLUETOOTH",		8, 		0x000000a7, 0x00000000, 0x00000000, 1, 		1, 		0x00000026 },
+		{ "CRC-16/CCITT",	  		16, 	0x00001021, 0x00000000, 0x00000000, 1, 		1, 		0x00002189 },
+		{ "CRC-16/ARC",	  			16,		0x00008005, 0x00000000, 0x00000000, 1, 		1, 		0x0000bb3d },
+		{ "CRC-24/OPENPGP",	  		24,		0x00864cfb, 0x00b704ce, 0x00000000, 0, 		0, 		0x0021cf02 },
+		{ "CRC-24/BLE",	  			24,		0x0000065b, 0x00555555, 0x00000000, 1, 		1, 		0x00c25a56 },
+		{ "CRC-24/FLEXRAY-B",	  	24,		0x005d6dcb, 0x00abcdef, 0x00000000, 0, 		0, 		0x001f23b8 },
+		{ "CRC-32",	  				32,		0x04c11db7, 0xffffffff, 0xffffffff, 1, 		1, 		0xcbf43926 },
+		{ "CRC-32C",	  			32,		0x1edc6f41, 0xffffffff, 0xffffffff, 1, 		1, 		0xe3069283 },
+		{ "CRC-32/AUTOSAR",	  		32,		0xf4acfb13, 0xffffffff, 0xffffffff, 1, 		1, 		0x1697d06a },
+		{ "CRC-32/BZIP2",	  		32,		0x04c11db7, 0xffffffff, 0xffffffff, 0, 		0, 		0xfc891918 },
+
+};
+
+int clbrzcrcx8_crc_algo_list_size = sizeof(clbrzcrcx8_crc_algo_list)/sizeof(CLBRZCRCx8_CRCTypeDescriptor_t);
+
+
+#if defined(CLBRZCRCX8_BUILD_TABLE_GENERATOR) || defined(CLBRZCRCX8_ENABLE_CRC_BENCHMARK)
+// the algo list entry with this name, NULL if there is none : the list can be reordered, positions are not stable.
+static CLBRZCRCx8_CRCTypeDescriptor_t* _clbrzcrcx8_find_algo(const char* name)
+{
+	int algo_index;
+
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		if(strcmp(name, clbrzcrcx8_crc_algo_list[algo_index].name) == 0)
+		{
+			return &clbrzcrcx8_crc_algo_list[algo_index];
+		}
+	}
+
+	return NULL;
+}
+#endif // #if defined(CLBRZCRCX8_BUILD_TABLE_GENERATOR) || defined(CLBRZCRCX8_ENABLE_CRC_BENCHMARK)
+
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_TEST
+
+int main()
+{
+	int failed = 0;
+
+	if(clbrzcrcx8_test() != 1)
+	{
+		failed++;
+	}
+
+	int i = 0;
+
+	printf("\n%-5s \t %-16s \t %-5s \t %-10s \t %-10s \t %-10s \t %-6s \t %-6s \t %-10s \n\n",
+			"index",
+			"name",
+			"width",
+			"poly",
+			"init",
+			"xor",
+			"refin",
+			"refout",
+			"check");
+	for (i = 0; i < clbrzcrcx8_crc_algo_list_size; i++)
+	{
+		printf("%-5d \t %-16s \t %-5d \t 0x%08x \t 0x%08x \t 0x%08x \t %-6d \t %-6d \t 0x%08x\n",
+				i,
+				clbrzcrcx8_crc_algo_list[i].name,
+				clbrzcrcx8_crc_algo_list[i].width,
+				clbrzcrcx8_crc_algo_list[i].polynomial,
+				clbrzcrcx8_crc_algo_list[i].initial_value,
+				clbrzcrcx8_crc_algo_list[i].final_xor_value,
+				clbrzcrcx8_crc_algo_list[i].reflect_input,
+				clbrzcrcx8_crc_algo_list[i].reflect_output,
+				clbrzcrcx8_crc_algo_list[i].check_value);
+
+
+		// enable the below code to test ALL the CRC algorithms added in the list!
+#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
+		clbrzcrcx8_init_crc(&clbrzcrcx8_crc_algo_list[i]);
+		if(clbrzcrcx8_self_test() == 1)
+		{
+			printf("self-check : PASS\n\n");
+		}
+		else
+		{
+			printf("self-check : FAIL\n\n");
+			failed++;
+		}
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
+
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
+		clbrzcrcx8_calculate_self_residue();
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
+	}
+
+	return (failed == 0) ? 0 : 1;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_TEST
+
+
+#ifdef CLBRZCRCX8_BUILD_TABLE_GENERATOR
+
+// build time table generator : emits const table sets for a list of algorithms from clbrzcrcx8_crc_algo_list[],
+// to be compiled in with CLBRZCRCX8_USE_GENERATED_TABLES. no startup cost, rodata, and never stale (make rebuilds it).
+// usage: clbrz_crcx8_gentables all|<algo name>... > clbrz_crcx8_tables.inc
+
+#ifndef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+#error "the table generator needs CLBRZCRCX8_ENABLE_TABLE_GENERATION"
+#endif // #ifndef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_TEST
+#error "the table generator and the crc test both define main(), build them separately"
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_TEST
+
+// emits the tables of one table set as a const array of its natural element width.
+static void _clbrzcrcx8_emit_table(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, int table_index)
+{
+	static uint32_t table_storage[CLBRZCRCX8_SLICING_DEPTH][256];		// big enough for any element width
+	clbrzcrcx8_table_set_t table_set;
+	uint16_t byte_value;
+	uint8_t slice_index;
+	int element_size = TABLE_ELEMENT_SIZE(crc_configuration_ptr->width);
+
+	table_set.polynomial = crc_configuration_ptr->polynomial & CRC_MASK(crc_configuration_ptr->width);
+	table_set.width = crc_configuration_ptr->width;
+	table_set.reflected = crc_configuration_ptr->reflect_input;
+	_clbrzcrcx8_build_table_set(&table_set, table_storage);
+
+	printf("// %s\n", crc_configuration_ptr->name);
+	printf("static const uint%d_t clbrzcrcx8_generated_table_%d[%d][256] =\n{\n", element_size * 8, table_index, CLBRZCRCX8_SLICING_DEPTH);
+
+	for (slice_index = 0; slice_index < CLBRZCRCX8_SLICING_DEPTH; slice_index++)
+	{
+		printf("\t{\n");
+		for (byte_value = 0; byte_value < 256; byte_value++)
+		{
+			// 4 bits = 1 hex, use format specifier * for variable based substitution, same as print_crc_table()
+			printf("%s0x%0*x,%s",
+					(byte_value % 8 == 0) ? "\t" : " ",
+					element_size * 2,
+					(element_size == 1) ? ((const uint8_t (*)[256])table_storage)[slice_index][byte_value] :
+					(element_size == 2) ? ((const uint16_t (*)[256])table_storage)[slice_index][byte_value] :
+					table_storage[slice_index][byte_value],
+					(byte_value % 8 == 7) ? "\n" : "");
+		}
+		printf("\t},\n");
+	}
+
+	printf("};\n\n");
+}
+
+
+int main(int argc, char* argv[])
+{
+	int arg_index;
+	int algo_index;
+	int emitted_index;
+	int emitted_count = 0;
+	int found;
+	const CLBRZCRCx8_CRCTypeDescriptor_t* named_algo;
+	// one table set per (poly, width, refin), algos that only differ in init/xorout share it.
+	const CLBRZCRCx8_CRCTypeDescriptor_t* emitted[sizeof(clbrzcrcx8_crc_algo_list)/sizeof(CLBRZCRCx8_CRCTypeDescriptor_t)];
+
+	if(argc < 2)
+	{
+		fprintf(stderr, "usage: %s all|<algo name>...\n", argv[0]);
+		return 1;
+	}
+
+	for (arg_index = 1; arg_index < argc; arg_index++)
+	{
+		found = 0;
+		named_algo = _clbrzcrcx8_find_algo(argv[arg_index]);
+		for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+		{
+			if(strcmp(argv[arg_index], "all") != 0 && &clbrzcrcx8_crc_algo_list[algo_index] != named_algo)
+			{
+				continue;
+			}
+			found = 1;
+
+			for (emitted_index = 0; emitted_index < emitted_count; emitted_index++)
+			{
+				if( (emitted[emitted_index]->polynomial & CRC_MASK(emitted[emitted_index]->width)) == (clbrzcrcx8_crc_algo_list[algo_index].polynomial & CRC_MASK(clbrzcrcx8_crc_algo_list[algo_index].width)) &&
+					emitted[emitted_index]->width == clbrzcrcx8_crc_algo_list[algo_index].width &&
+					emitted[emitted_index]->reflect_input == clbrzcrcx8_crc_algo_list[algo_index].reflect_input )
+				{
+					break;
+				}
+			}
+
+			if(emitted_index == emitted_count)
+			{
+				emitted[emitted_count++] = &clbrzcrcx8_crc_algo_list[algo_index];
+			}
+		}
+
+		if(!found)
+		{
+			fprintf(stderr, "%s: unknown algorithm \"%s\", see clbrzcrcx8_crc_algo_list[]\n", argv[0], argv[arg_index]);
+			return 1;
+		}
+	}
+
+	printf("// GENERATED by the clbrz_crcx8 table generator, DO NOT EDIT, rebuild instead.\n");
+	printf("// slicing depth: %d\n\n", CLBRZCRCX8_SLICING_DEPTH);
+	printf("#if (CLBRZCRCX8_SLICING_DEPTH != %d)\n", CLBRZCRCX8_SLICING_DEPTH);
+	printf("#error \"clbrz_crcx8_tables.inc was generated for CLBRZCRCX8_SLICING_DEPTH %d, regenerate it\"\n", CLBRZCRCX8_SLICING_DEPTH);
+	printf("#endif\n\n");
+
+	for (emitted_index = 0; emitted_index < emitted_count; emitted_index++)
+	{
+		_clbrzcrcx8_emit_table(emitted[emitted_index], emitted_index);
+	}
+
+	printf("static const clbrzcrcx8_table_set_t clbrzcrcx8_generated_table_sets[] =\n{\n");
+	for (emitted_index = 0; emitted_index < emitted_count; emitted_index++)
+	{
+		printf("\t{ 0x%08x, %d, %d, clbrzcrcx8_generated_table_%d },\t// %s\n",
+				(unsigned int)(emitted[emitted_index]->polynomial & CRC_MASK(emitted[emitted_index]->width)),
+				emitted[emitted_index]->width,
+				emitted[emitted_index]->reflect_input,
+				emitted_index,
+				emitted[emitted_index]->name);
+	}
+	printf("};\n\n");
+	printf("static const int clbrzcrcx8_generated_table_sets_size = %d;\n", emitted_count);
+
+	return 0;
+}
+
+#endif // #ifdef CLBRZCRCX8_BUILD_TABLE_GENERATOR
+
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_BENCHMARK
+
+// small-record benchmark : ns per record for a few algorithms, with and without cache pressure.
+// cache pressure = a hot working set, standing in for the rest of the packet path, is walked between records,
+// so the crc tables have to compete for L1 : the compact (natural width) tables of crc-8/16 should suffer less.
+
+#if defined(CLBRZCRCX8_ENABLE_CRC_TEST) || defined(CLBRZCRCX8_BUILD_TABLE_GENERATOR)
+#error "the benchmark, the crc test and the table generator all define main(), build them separately"
+#endif
+
+#include <time.h>
+
+#define BENCHMARK_RECORD_SIZE		64
+#define BENCHMARK_RECORD_COUNT		4096
+#define BENCHMARK_ROUNDS			64
+#ifndef BENCHMARK_HOT_SET_SIZE
+#define BENCHMARK_HOT_SET_SIZE		(28 * 1024)		// most of a typical 32 KiB L1d
+#endif // #ifndef BENCHMARK_HOT_SET_SIZE
+
+static uint8_t benchmark_data[BENCHMARK_RECORD_COUNT * BENCHMARK_RECORD_SIZE];
+static volatile uint8_t benchmark_hot_set[BENCHMARK_HOT_SET_SIZE];
+
+
+static double _clbrzcrcx8_benchmark_now_ns()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+
+static void _clbrzcrcx8_benchmark_touch_hot_set()
+{
+	int hot_set_index;
+
+	for (hot_set_index = 0; hot_set_index < BENCHMARK_HOT_SET_SIZE; hot_set_index += 64)
+	{
+		benchmark_hot_set[hot_set_index]++;
+	}
+}
+
+
+// returns ns per record, cache_pressure=1 walks the hot set between records (its own cost is subtracted).
+static double _clbrzcrcx8_benchmark_run(CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, int cache_pressure)
+{
+	int round_index;
+	int record_index;
+	uint32_t crc_sink = 0;
+	double start_ns;
+	double crc_ns;
+	double hot_set_ns = 0;
+
+	clbrzcrcx8_init_crc(crc_configuration_ptr);
+
+	start_ns = _clbrzcrcx8_benchmark_now_ns();
+	for (round_index = 0; round_index < BENCHMARK_ROUNDS; round_index++)
+	{
+		for (record_index = 0; record_index < BENCHMARK_RECORD_COUNT; record_index++)
+		{
+			clbrzcrcx8_reset_crc_chunk();
+			clbrzcrcx8_calculate_crc_chunk(&benchmark_data[record_index * BENCHMARK_RECORD_SIZE], BENCHMARK_RECORD_SIZE);
+			crc_sink ^= clbrzcrcx8_finalize_crc();
+			if(cache_pressure)
+			{
+				_clbrzcrcx8_benchmark_touch_hot_set();
+			}
+		}
+	}
+	crc_ns = _clbrzcrcx8_benchmark_now_ns() - start_ns;
+
+	if(cache_pressure)
+	{
+		start_ns = _clbrzcrcx8_benchmark_now_ns();
+		for (round_index = 0; round_index < BENCHMARK_ROUNDS; round_index++)
+		{
+			for (record_index = 0; record_index < BENCHMARK_RECORD_COUNT; record_index++)
+			{
+				_clbrzcrcx8_benchmark_touch_hot_set();
+			}
+		}
+		hot_set_ns = _clbrzcrcx8_benchmark_now_ns() - start_ns;
+	}
+
+	benchmark_hot_set[0] ^= (uint8_t)crc_sink;	// keep the crc work alive
+
+	return (crc_ns - hot_set_ns) / ((double)BENCHMARK_ROUNDS * BENCHMARK_RECORD_COUNT);
+}
+
+
+// same records, through clbrzcrcx8_calculate_crc_batch(), returns ns per record.
+static double _clbrzcrcx8_benchmark_run_batch(CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr)
+{
+	static const uint8_t* records[BENCHMARK_RECORD_COUNT];
+	static size_t record_lengths[BENCHMARK_RECORD_COUNT];
+	static uint32_t crcs[BENCHMARK_RECORD_COUNT];
+	int round_index;
+	int record_index;
+	double start_ns;
+
+	for (record_index = 0; record_index < BENCHMARK_RECORD_COUNT; record_index++)
+	{
+		records[record_index] = &benchmark_data[record_index * BENCHMARK_RECORD_SIZE];
+		record_lengths[record_index] = BENCHMARK_RECORD_SIZE;
+	}
+
+	start_ns = _clbrzcrcx8_benchmark_now_ns();
+	for (round_index = 0; round_index < BENCHMARK_ROUNDS; round_index++)
+	{
+		clbrzcrcx8_calculate_crc_batch(crc_configuration_ptr, records, record_lengths, crcs, BENCHMARK_RECORD_COUNT);
+		benchmark_hot_set[0] ^= (uint8_t)crcs[round_index];
+	}
+
+	return (_clbrzcrcx8_benchmark_now_ns() - start_ns) / ((double)BENCHMARK_ROUNDS * BENCHMARK_RECORD_COUNT);
+}
+
+
+// one pass : CRC-32, CRC-32C and CRC-16/CCITT over the same buffer, once per algorithm and in one pass, GB/s of data.
+#define MULTI_BENCHMARK_SIZE			(64UL * 1024 * 1024)
+#define MULTI_BENCHMARK_ALGOS			3
+
+static void _clbrzcrcx8_benchmark_multi(const uint8_t* multi_data)
+{
+	static const char* const algo_names[MULTI_BENCHMARK_ALGOS] = { "CRC-32", "CRC-32C", "CRC-16/CCITT" };
+	const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configurations[MULTI_BENCHMARK_ALGOS];
+	uint32_t crcs[MULTI_BENCHMARK_ALGOS];
+	double start_ns;
+	double separate_ns;
+	double multi_ns;
+	int algo_index;
+
+	for (algo_index = 0; algo_index < MULTI_BENCHMARK_ALGOS; algo_index++)
+	{
+		crc_configurations[algo_index] = _clbrzcrcx8_find_algo(algo_names[algo_index]);
+		if(crc_configurations[algo_index] == NULL)
+		{
+			printf("\nmulti : no %s in the algo list, skipped\n", algo_names[algo_index]);
+			return;
+		}
+	}
+
+	start_ns = _clbrzcrcx8_benchmark_now_ns();
+	for (algo_index = 0; algo_index < MULTI_BENCHMARK_ALGOS; algo_index++)
+	{
+		crcs[algo_index] = clbrzcrcx8_calculate_crc(crc_configurations[algo_index], multi_data, MULTI_BENCHMARK_SIZE);
+	}
+	separate_ns = _clbrzcrcx8_benchmark_now_ns() - start_ns;
+	benchmark_hot_set[0] ^= (uint8_t)(crcs[0] ^ crcs[1] ^ crcs[2]);
+
+	start_ns = _clbrzcrcx8_benchmark_now_ns();
+	clbrzcrcx8_calculate_crc_multi(crc_configurations, crcs, MULTI_BENCHMARK_ALGOS, multi_data, MULTI_BENCHMARK_SIZE);
+	multi_ns = _clbrzcrcx8_benchmark_now_ns() - start_ns;
+	benchmark_hot_set[0] ^= (uint8_t)(crcs[0] ^ crcs[1] ^ crcs[2]);
+
+	printf("\n%lu MiB, %s + %s + %s : separate %.2f GB/s, one pass %.2f GB/s\n",
+			MULTI_BENCHMARK_SIZE >> 20, algo_names[0], algo_names[1], algo_names[2],
+			(double)MULTI_BENCHMARK_SIZE / separate_ns, (double)MULTI_BENCHMARK_SIZE / multi_ns);
+}
+
+
+#ifdef CLBRZCRCX8_ENABLE_PARALLEL
+// parallel : CRC-32 of the same buffer, one thread against one per online cpu.
+static void _clbrzcrcx8_benchmark_parallel(const uint8_t* parallel_data)
+{
+	const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr = _clbrzcrcx8_find_algo("CRC-32");
+	double start_ns;
+	double single_ns;
+	double parallel_ns;
+	uint32_t crc;
+
+	if(crc_configuration_ptr == NULL)
+	{
+		printf("parallel : no CRC-32 in the algo list, skipped\n");
+		return;
+	}
+
+	start_ns = _clbrzcrcx8_benchmark_now_ns();
+	crc = clbrzcrcx8_calculate_crc_parallel(crc_configuration_ptr, parallel_data, MULTI_BENCHMARK_SIZE, 1);
+	single_ns = _clbrzcrcx8_benchmark_now_ns() - start_ns;
+
+	start_ns = _clbrzcrcx8_benchmark_now_ns();
+	crc ^= clbrzcrcx8_calculate_crc_parallel(crc_configuration_ptr, parallel_data, MULTI_BENCHMARK_SIZE, 0);
+	parallel_ns = _clbrzcrcx8_benchmark_now_ns() - start_ns;
+	benchmark_hot_set[0] ^= (uint8_t)crc;
+
+	printf("%lu MiB, CRC-32 parallel : 1 thread %.2f GB/s, %ld threads %.2f GB/s\n",
+			MULTI_BENCHMARK_SIZE >> 20, (double)MULTI_BENCHMARK_SIZE / single_ns,
+			sysconf(_SC_NPROCESSORS_ONLN), (double)MULTI_BENCHMARK_SIZE / parallel_ns);
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_PARALLEL
+
+
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+// calibration : what it costs at start-up, and the engine it picked per size class (0 bitwise, 1 table, 2 slicing),
+// the record numbers below then run with these plans.
+static void _clbrzcrcx8_benchmark_calibration()
+{
+	CLBRZCRCx8_CalibrationPlan_t plan;
+	int algo_index;
+	unsigned int size_class;
+	double start_ns;
+	double calibration_ns;
+
+	printf("%-16s \t %-8s \t engine per size class 1B..8KiB+\n\n", "name", "ms");
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		start_ns = _clbrzcrcx8_benchmark_now_ns();
+		if(clbrzcrcx8_calibrate(&clbrzcrcx8_crc_algo_list[algo_index], &plan) != 1)
+		{
+			continue;
+		}
+		calibration_ns = _clbrzcrcx8_benchmark_now_ns() - start_ns;
+
+		printf("%-16s \t %-8.2f \t ", clbrzcrcx8_crc_algo_list[algo_index].name, calibration_ns / 1e6);
+		for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+		{
+			printf("%d", plan.engines[size_class]);
+		}
+		printf("\n");
+	}
+	printf("\n");
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+
+#ifdef CLBRZCRCX8_ENABLE_SCRUB
+// scrub : GB/s over a buffer much larger than the caches, and what it costs a neighbour : the ns per line to walk
+// its (LLC sized) working set again after every SCRUB_BENCHMARK_SLICE of scrubbing.
+#define SCRUB_BENCHMARK_SIZE			(256UL * 1024 * 1024)
+#define SCRUB_BENCHMARK_SLICE			(8UL * 1024 * 1024)
+#define SCRUB_BENCHMARK_NEIGHBOUR_SIZE	(2UL * 1024 * 1024)
+
+static void _clbrzcrcx8_benchmark_scrub(const char* mode_name, const uint8_t* scrub_data, volatile uint8_t* neighbour_data,
+										size_t prefetch_distance, uint8_t non_temporal, uint64_t rate_limit_bytes_per_sec)
+{
+	CLBRZCRCx8_ScrubConfig_t scrub_config;
+	size_t slice_offset;
+	size_t line_offset;
+	double start_ns;
+	double scrub_ns = 0;
+	double neighbour_ns = 0;
+	size_t scrub_size = (rate_limit_bytes_per_sec > 0) ? (SCRUB_BENCHMARK_SIZE / 8) : SCRUB_BENCHMARK_SIZE;
+
+	clbrzcrcx8_init_scrub(&scrub_config, prefetch_distance, non_temporal, rate_limit_bytes_per_sec);
+	for (slice_offset = 0; slice_offset < scrub_size; slice_offset += SCRUB_BENCHMARK_SLICE)
+	{
+		start_ns = _clbrzcrcx8_benchmark_now_ns();
+		clbrzcrcx8_calculate_crc_scrub(&scrub_config, scrub_data + slice_offset, SCRUB_BENCHMARK_SLICE);
+		scrub_ns += _clbrzcrcx8_benchmark_now_ns() - start_ns;
+
+		start_ns = _clbrzcrcx8_benchmark_now_ns();
+		for (line_offset = 0; line_offset < SCRUB_BENCHMARK_NEIGHBOUR_SIZE; line_offset += 64)
+		{
+			neighbour_data[line_offset]++;
+		}
+		neighbour_ns += _clbrzcrcx8_benchmark_now_ns() - start_ns;
+	}
+
+	printf("%-24s \t %-10.2f \t %-12.2f\n", mode_name, (double)scrub_size / scrub_ns,
+			neighbour_ns / ((double)(scrub_size / SCRUB_BENCHMARK_SLICE) * (SCRUB_BENCHMARK_NEIGHBOUR_SIZE / 64)));
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_SCRUB
+
+
+int main()
+{
+	int algo_index;
+	int data_index;
+	int table_bytes;
+
+	srand(0x5eed);
+	for (data_index = 0; data_index < (int)sizeof(benchmark_data); data_index++)
+	{
+		benchmark_data[data_index] = (uint8_t)rand();
+	}
+
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+	_clbrzcrcx8_benchmark_calibration();
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+	printf("%d byte records, hot set %d bytes\n\n", BENCHMARK_RECORD_SIZE, BENCHMARK_HOT_SET_SIZE);
+	printf("%-16s \t %-5s \t %-11s \t %-12s \t %-12s \t %-12s\n\n", "name", "width", "table bytes", "ns/record", "ns/record hot", "ns/rec batch");
+
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+		table_bytes = TABLE_SET_STORAGE_SIZE(clbrzcrcx8_crc_algo_list[algo_index].width);
+#elif defined(CLBRZCRCX8_USE_TABLE_FOR_CRC)
+		table_bytes = (int)sizeof(clbrzcrcx8_crc_table);
+#else
+		table_bytes = 0;
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+		printf("%-16s \t %-5d \t %-11d \t %-12.1f \t %-12.1f \t %-12.1f\n",
+				clbrzcrcx8_crc_algo_list[algo_index].name,
+				clbrzcrcx8_crc_algo_list[algo_index].width,
+				table_bytes,
+				_clbrzcrcx8_benchmark_run(&clbrzcrcx8_crc_algo_list[algo_index], 0),
+				_clbrzcrcx8_benchmark_run(&clbrzcrcx8_crc_algo_list[algo_index], 1),
+				_clbrzcrcx8_benchmark_run_batch(&clbrzcrcx8_crc_algo_list[algo_index]));
+	}
+
+	{
+		uint8_t* multi_data = (uint8_t*)malloc(MULTI_BENCHMARK_SIZE);
+
+		if(multi_data != NULL)
+		{
+			memset(multi_data, 0xa5, MULTI_BENCHMARK_SIZE);
+			_clbrzcrcx8_benchmark_multi(multi_data);
+#ifdef CLBRZCRCX8_ENABLE_PARALLEL
+			_clbrzcrcx8_benchmark_parallel(multi_data);
+#endif // #ifdef CLBRZCRCX8_ENABLE_PARALLEL
+		}
+		free(multi_data);
+	}
+
+#ifdef CLBRZCRCX8_ENABLE_SCRUB
+	{
+		CLBRZCRCx8_CRCTypeDescriptor_t* scrub_algo = _clbrzcrcx8_find_algo("CRC-32");
+		uint8_t* scrub_data = (uint8_t*)malloc(SCRUB_BENCHMARK_SIZE);
+		uint8_t* neighbour_data = (uint8_t*)calloc(1, SCRUB_BENCHMARK_NEIGHBOUR_SIZE);
+
+		if(scrub_algo == NULL)
+		{
+			printf("\nscrub : no CRC-32 in the algo list, skipped\n");
+		}
+		else if((scrub_data != NULL) && (neighbour_data != NULL))
+		{
+			memset(scrub_data, 0x5a, SCRUB_BENCHMARK_SIZE);
+			clbrzcrcx8_init_crc(scrub_algo);
+
+			printf("\nscrub %lu MiB, %s, neighbour working set %lu KiB\n\n",
+					SCRUB_BENCHMARK_SIZE >> 20, scrub_algo->name, SCRUB_BENCHMARK_NEIGHBOUR_SIZE >> 10);
+			printf("%-24s \t %-10s \t %-12s\n\n", "mode", "GB/s", "neighbour ns/line");
+			_clbrzcrcx8_benchmark_scrub("no prefetch", scrub_data, neighbour_data, 0, 0, 0);
+			_clbrzcrcx8_benchmark_scrub("prefetch 1KiB", scrub_data, neighbour_data, 1024, 0, 0);
+			_clbrzcrcx8_benchmark_scrub("prefetch 1KiB nt", scrub_data, neighbour_data, 1024, 1, 0);
+			_clbrzcrcx8_benchmark_scrub("prefetch 1KiB nt 512MB/s", scrub_data, neighbour_data, 1024, 1, 512UL * 1000 * 1000);
+		}
+		free(scrub_data);
+		free(neighbour_data);
+	}
+#endif // #ifdef CLBRZCRCX8_ENABLE_SCRUB
+
+	return 0;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_BENCHMARK
+
+
+#if defined(CLBRZCRCX8_ENABLE_CRC_FUZZ_TEST) || defined(CLBRZCRCX8_ENABLE_CRC_FUZZER)
+
+// differential test : every engine compiled in must give the same crc as the bitwise reference,
+// _clbrzcrcx8_update_bitwise(), for the same data, however the data is split, aligned or batched.
+// CLBRZCRCX8_ENABLE_CRC_FUZZ_TEST : main() with random data, lengths 0..64KiB, random splits and alignments.
+// CLBRZCRCX8_ENABLE_CRC_FUZZER : LLVMFuzzerTestOneInput() for libFuzzer, see the Makefile fuzz target.
+
+#if defined(CLBRZCRCX8_ENABLE_CRC_TEST) || defined(CLBRZCRCX8_BUILD_TABLE_GENERATOR) || defined(CLBRZCRCX8_ENABLE_CRC_BENCHMARK)
+#error "the fuzz test, the benchmark, the crc test and the table generator all define main(), build them separately"
+#endif
+
+#define FUZZ_MAX_DATA_SIZE			(64 * 1024)
+#define FUZZ_ALIGNMENT_SLACK		64			// data is copied to a random offset in [0, 64)
+#define FUZZ_MAX_SPLITS				16
+#define FUZZ_BATCH_RECORDS			40			// more than one SIMD group for every width, plus a remainder
+#define FUZZ_MULTI_ALGOS			20			// up to more than two groups of the one pass api
+
+static uint8_t fuzz_buffer[FUZZ_MAX_DATA_SIZE + FUZZ_ALIGNMENT_SLACK];
+
+
+// xorshift32 : reproducible from the seed, which is printed on failure.
+static uint32_t _clbrzcrcx8_fuzz_random(uint32_t* random_state)
+{
+	uint32_t x = *random_state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*random_state = x;
+	return x;
+}
+
+
+static uint32_t _clbrzcrcx8_fuzz_reference(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+											const uint8_t* byte_data, size_t data_len)
+{
+	uint32_t calculated_crc = crc_configuration_ptr->initial_value & CRC_MASK(crc_configuration_ptr->width);
+
+	calculated_crc = _clbrzcrcx8_update_bitwise(crc_configuration_ptr, calculated_crc, byte_data, data_len);
+
+	return _clbrzcrcx8_finalize(crc_configuration_ptr, calculated_crc);
+}
+
+
+static int _clbrzcrcx8_fuzz_report(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, const char* engine_name,
+									size_t data_len, uint32_t expected_crc, uint32_t calculated_crc)
+{
+	printf("%-16s : %s mismatch, len %u : expected 0x%08x got 0x%08x\n",
+			crc_configuration_ptr->name, engine_name, (unsigned int)data_len,
+			(unsigned int)expected_crc, (unsigned int)calculated_crc);
+	return 0;
+}
+
+
+// the public api can only be right for a configuration the build has a table (or no tables at all) for :
+// the fixed global table is for crc poly 0x04c11db7 width 32 only, see CLBRZCRCX8_ENABLE_TABLE_GENERATION.
+static int _clbrzcrcx8_fuzz_supported(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr)
+{
+#if !defined(CLBRZCRCX8_USE_TABLE_FOR_CRC) || defined(CLBRZCRCX8_ENABLE_TABLE_GENERATION)
+	(void)crc_configuration_ptr;
+	return 1;
+#else
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	if(_clbrzcrcx8_find_table_set(crc_configuration_ptr->polynomial, crc_configuration_ptr->width, crc_configuration_ptr->reflect_input) != NULL)
+	{
+		return 1;
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+#ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+	return (crc_configuration_ptr->width == 32) && (crc_configuration_ptr->polynomial == 0x04c11db7);
+#else
+	return 0;
+#endif // #ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+#endif // #if !defined(CLBRZCRCX8_USE_TABLE_FOR_CRC) || defined(CLBRZCRCX8_ENABLE_TABLE_GENERATION)
+}
+
+
+// one data buffer through every engine, 1 = all agree with the reference.
+static int _clbrzcrcx8_fuzz_check(CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+									const uint8_t* source_data, size_t data_len, uint32_t* random_state)
+{
+	const uint8_t* byte_data;
+	const uint8_t* records[FUZZ_BATCH_RECORDS];
+	size_t record_lengths[FUZZ_BATCH_RECORDS];
+	uint32_t batch_crcs[FUZZ_BATCH_RECORDS];
+	size_t split_points[FUZZ_MAX_SPLITS + 1];
+	size_t split_count;
+	size_t split_index;
+	size_t record_index;
+	uint32_t expected_crc;
+	uint32_t calculated_crc;
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	const clbrzcrcx8_table_set_t* table_set;
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+#ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+	int global_table_fits;
+#endif // #ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+	CLBRZCRCx8_CRCState_t crc_state;
+	uint8_t checkpoint[CLBRZCRCX8_CHECKPOINT_SIZE];
+	uint8_t crafted_checkpoint[CLBRZCRCX8_CHECKPOINT_SIZE];
+#ifdef CLBRZCRCX8_ENABLE_SCRUB
+	CLBRZCRCx8_ScrubConfig_t scrub_config;
+#endif // #ifdef CLBRZCRCX8_ENABLE_SCRUB
+
+	// random alignment for the engines that care (slicing head/tail, SIMD loads).
+	byte_data = memmove(&fuzz_buffer[_clbrzcrcx8_fuzz_random(random_state) % FUZZ_ALIGNMENT_SLACK], source_data, data_len);
+
+	expected_crc = _clbrzcrcx8_fuzz_reference(crc_configuration_ptr, byte_data, data_len);
+
+	// public streaming api, in one go, and after a reset : no state may leak from the previous run.
+	clbrzcrcx8_init_crc(crc_configuration_ptr);
+	clbrzcrcx8_calculate_crc_buffer(byte_data, data_len);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	if(calculated_crc != expected_crc)
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "calculate_crc_buffer", data_len, expected_crc, calculated_crc);
+	}
+
+	// incremental : crc(a || b || ...) == crc over the same data fed in random pieces, some of them empty.
+	split_count = _clbrzcrcx8_fuzz_random(random_state) % (FUZZ_MAX_SPLITS + 1);
+	for (split_index = 0; split_index < split_count; split_index++)
+	{
+		split_points[split_index] = (data_len == 0) ? 0 : (_clbrzcrcx8_fuzz_random(random_state) % (data_len + 1));
+	}
+	split_points[split_count] = data_len;
+	for (split_index = 1; split_index <= split_count; split_index++)	// insertion sort, at most 17 points
+	{
+		size_t split_point = split_points[split_index];
+		size_t sort_index = split_index;
+		while((sort_index > 0) && (split_points[sort_index - 1] > split_point))
+		{
+			split_points[sort_index] = split_points[sort_index - 1];
+			sort_index--;
+		}
+		split_points[sort_index] = split_point;
+	}
+
+	clbrzcrcx8_reset_crc_chunk();
+	for (split_index = 0; split_index <= split_count; split_index++)
+	{
+		size_t piece_start = (split_index == 0) ? 0 : split_points[split_index - 1];
+		size_t piece_len = split_points[split_index] - piece_start;
+
+		// alternate the two entry points, the old one only for what fits its int32_t length.
+		if((split_index & 1) && (piece_len <= INT32_MAX))
+		{
+			clbrzcrcx8_calculate_crc_chunk((uint8_t*)byte_data + piece_start, (int32_t)piece_len);
+		}
+		else
+		{
+			clbrzcrcx8_calculate_crc_buffer(byte_data + piece_start, piece_len);
+		}
+	}
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	if(calculated_crc != expected_crc)
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "split chunks", data_len, expected_crc, calculated_crc);
+	}
+
+#ifdef CLBRZCRCX8_ENABLE_SCRUB
+	// scrub : same crc whatever the prefetch distance and hint, rate limit high enough to never sleep here.
+	clbrzcrcx8_init_scrub(&scrub_config, _clbrzcrcx8_fuzz_random(random_state) % (4 * SCRUB_STEP_SIZE),
+							(uint8_t)(_clbrzcrcx8_fuzz_random(random_state) & 1),
+							(_clbrzcrcx8_fuzz_random(random_state) & 1) ? 0 : (1ULL << 40));
+	clbrzcrcx8_reset_crc_chunk();
+	clbrzcrcx8_calculate_crc_scrub(&scrub_config, byte_data, data_len);
+	calculated_crc = clbrzcrcx8_finalize_crc();
+	if(calculated_crc != expected_crc)
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "scrub", data_len, expected_crc, calculated_crc);
+	}
+#endif // #ifdef CLBRZCRCX8_ENABLE_SCRUB
+
+#ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+	// every table set that exists for this configuration : build time const, and runtime generated.
+	table_set = _clbrzcrcx8_find_table_set(crc_configuration_ptr->polynomial, crc_configuration_ptr->width, crc_configuration_ptr->reflect_input);
+	if(table_set != NULL)
+	{
+		calculated_crc = _clbrzcrcx8_update_table_set(table_set, crc_configuration_ptr->initial_value & CRC_MASK(crc_configuration_ptr->width),
+														byte_data, data_len);
+		calculated_crc = _clbrzcrcx8_finalize(crc_configuration_ptr, calculated_crc);
+		if(calculated_crc != expected_crc)
+		{
+			return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "table set", data_len, expected_crc, calculated_crc);
+		}
+	}
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+	table_set = _clbrzcrcx8_get_table_set(crc_configuration_ptr->polynomial & CRC_MASK(crc_configuration_ptr->width),
+											crc_configuration_ptr->width, crc_configuration_ptr->reflect_input);
+	if(table_set != NULL)
+	{
+		calculated_crc = _clbrzcrcx8_update_table_set(table_set, crc_configuration_ptr->initial_value & CRC_MASK(crc_configuration_ptr->width),
+														byte_data, data_len);
+		calculated_crc = _clbrzcrcx8_finalize(crc_configuration_ptr, calculated_crc);
+		if(calculated_crc != expected_crc)
+		{
+			return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "runtime table set", data_len, expected_crc, calculated_crc);
+		}
+	}
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+#endif // #ifdef CLBRZCRCX8_HAVE_TABLE_SETS
+
+#ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+	// the single global table : generated for this configuration, or the fixed one, which only fits crc-32 poly 0x04c11db7.
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+	clbrzcrcx8_generate_crc_table();
+	global_table_fits = 1;
+#else
+	global_table_fits = (crc_configuration_ptr->width == 32) && (crc_configuration_ptr->polynomial == 0x04c11db7);
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+	if(global_table_fits)
+	{
+		calculated_crc = _clbrzcrcx8_update_global_table(crc_configuration_ptr, crc_configuration_ptr->initial_value & CRC_MASK(crc_configuration_ptr->width),
+															byte_data, data_len);
+		calculated_crc = _clbrzcrcx8_finalize(crc_configuration_ptr, calculated_crc);
+		if(calculated_crc != expected_crc)
+		{
+			return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "global table", data_len, expected_crc, calculated_crc);
+		}
+	}
+#endif // #ifdef CLBRZCRCX8_HAVE_GLOBAL_TABLE
+
+	// state : the same pieces, and the state is copied out and back in as bytes between pieces (suspend / move).
+	clbrzcrcx8_init_crc_state(&crc_state, crc_configuration_ptr);
+	for (split_index = 0; split_index <= split_count; split_index++)
+	{
+		size_t piece_start = (split_index == 0) ? 0 : split_points[split_index - 1];
+		uint8_t suspended_state[sizeof(CLBRZCRCx8_CRCState_t)];
+
+		clbrzcrcx8_update_crc_state(&crc_state, byte_data + piece_start, split_points[split_index] - piece_start);
+		memcpy(suspended_state, &crc_state, sizeof(suspended_state));
+		memset(&crc_state, 0xa5, sizeof(crc_state));
+		memcpy(&crc_state, suspended_state, sizeof(suspended_state));
+	}
+	calculated_crc = clbrzcrcx8_finalize_crc_state(&crc_state);
+	if((calculated_crc != expected_crc) || (crc_state.byte_count != data_len))
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "crc state", data_len, expected_crc, calculated_crc);
+	}
+
+	// checkpoint : export after a random first part, a damaged copy must be refused, the good one resumes,
+	// and the rest goes in by its crc alone (append), not by its data.
+	split_index = (data_len == 0) ? 0 : (_clbrzcrcx8_fuzz_random(random_state) % (data_len + 1));
+	clbrzcrcx8_init_crc_state(&crc_state, crc_configuration_ptr);
+	clbrzcrcx8_update_crc_state(&crc_state, byte_data, split_index);
+	clbrzcrcx8_export_crc_state(&crc_state, checkpoint);
+	memset(&crc_state, 0, sizeof(crc_state));
+	checkpoint[_clbrzcrcx8_fuzz_random(random_state) % CLBRZCRCX8_CHECKPOINT_SIZE] ^= (uint8_t)(1 << (_clbrzcrcx8_fuzz_random(random_state) % 8));
+	if(clbrzcrcx8_import_crc_state(&crc_state, checkpoint, NULL) != 0)
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "damaged checkpoint", data_len, 0, 0);
+	}
+	clbrzcrcx8_init_crc_state(&crc_state, crc_configuration_ptr);
+	clbrzcrcx8_update_crc_state(&crc_state, byte_data, split_index);
+	clbrzcrcx8_export_crc_state(&crc_state, checkpoint);
+	memset(&crc_state, 0, sizeof(crc_state));
+	// an intact check over a reflect flag no descriptor has (not 0 or 1) : refused as well.
+	memcpy(crafted_checkpoint, checkpoint, sizeof(crafted_checkpoint));
+	crafted_checkpoint[(_clbrzcrcx8_fuzz_random(random_state) & 1) ? CHECKPOINT_REFLECT_INPUT : CHECKPOINT_REFLECT_OUTPUT] =
+		(uint8_t)(2 + _clbrzcrcx8_fuzz_random(random_state) % 254);
+	_clbrzcrcx8_put_le(&crafted_checkpoint[CHECKPOINT_CHECK],
+						clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, crafted_checkpoint, CHECKPOINT_CHECK), 4);
+	if(clbrzcrcx8_import_crc_state(&crc_state, crafted_checkpoint, NULL) != 0)
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "crafted checkpoint", data_len, 0, 0);
+	}
+	if(clbrzcrcx8_import_crc_state(&crc_state, checkpoint, crc_configuration_ptr) != 1)
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "checkpoint import", data_len, 0, 0);
+	}
+	clbrzcrcx8_append_crc_state(&crc_state, clbrzcrcx8_calculate_crc(crc_configuration_ptr, byte_data + split_index, data_len - split_index),
+								data_len - split_index);
+	calculated_crc = clbrzcrcx8_finalize_crc_state(&crc_state);
+	if((calculated_crc != expected_crc) || (crc_state.byte_count != data_len))
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "checkpoint + append", data_len, expected_crc, calculated_crc);
+	}
+
+	// combine : crc(A || B) == combine(crc(A), crc(B), len(B)), split at a random point, also at 0 and at the end.
+	split_index = (data_len == 0) ? 0 : (_clbrzcrcx8_fuzz_random(random_state) % (data_len + 1));
+	calculated_crc = clbrzcrcx8_combine_crc(crc_configuration_ptr,
+											clbrzcrcx8_calculate_crc(crc_configuration_ptr, byte_data, split_index),
+											clbrzcrcx8_calculate_crc(crc_configuration_ptr, byte_data + split_index, data_len - split_index),
+											data_len - split_index);
+	if(calculated_crc != expected_crc)
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "combine", data_len, expected_crc, calculated_crc);
+	}
+
+#ifdef CLBRZCRCX8_ENABLE_PARALLEL
+	// the fuzz build shrinks CLBRZCRCX8_PARALLEL_MIN_SEGMENT, so these short buffers do get split over the threads.
+	calculated_crc = clbrzcrcx8_calculate_crc_parallel(crc_configuration_ptr, byte_data, data_len, 1 + _clbrzcrcx8_fuzz_random(random_state) % 8);
+	if(calculated_crc != expected_crc)
+	{
+		return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "parallel", data_len, expected_crc, calculated_crc);
+	}
+#endif // #ifdef CLBRZCRCX8_ENABLE_PARALLEL
+
+	// batch : random pieces of the data as independent records, mostly short, some empty.
+	for (record_index = 0; record_index < FUZZ_BATCH_RECORDS; record_index++)
+	{
+		size_t record_start = (data_len == 0) ? 0 : (_clbrzcrcx8_fuzz_random(random_state) % data_len);
+		size_t record_max = data_len - record_start;
+
+		records[record_index] = byte_data + record_start;
+		record_lengths[record_index] = (record_max == 0) ? 0 : (_clbrzcrcx8_fuzz_random(random_state) % ((record_max < 300) ? record_max + 1 : 300));
+	}
+	clbrzcrcx8_calculate_crc_batch(crc_configuration_ptr, records, record_lengths, batch_crcs, FUZZ_BATCH_RECORDS);
+	for (record_index = 0; record_index < FUZZ_BATCH_RECORDS; record_index++)
+	{
+		expected_crc = _clbrzcrcx8_fuzz_reference(crc_configuration_ptr, records[record_index], record_lengths[record_index]);
+		if(batch_crcs[record_index] != expected_crc)
+		{
+			return _clbrzcrcx8_fuzz_report(crc_configuration_ptr, "batch", record_lengths[record_index], expected_crc, batch_crcs[record_index]);
+		}
+	}
+
+	return 1; // ok.
+}
+
+
+// a random pick of the algorithms (repeats allowed, sometimes more than one group) through the one pass api,
+// once in one go and once as a stream split at a random point.
+static int _clbrzcrcx8_fuzz_check_multi(const uint8_t* source_data, size_t data_len, uint32_t* random_state)
+{
+	const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configurations[FUZZ_MULTI_ALGOS];
+	CLBRZCRCx8_CRCState_t crc_states[FUZZ_MULTI_ALGOS];
+	uint32_t crcs[FUZZ_MULTI_ALGOS];
+	const uint8_t* byte_data;
+	size_t algo_count = 1 + _clbrzcrcx8_fuzz_random(random_state) % FUZZ_MULTI_ALGOS;
+	size_t algo_index;
+	size_t split_index;
+	uint32_t expected_crc;
+
+	for (algo_index = 0; algo_index < algo_count; algo_index++)
+	{
+		do
+		{
+			crc_configurations[algo_index] = &clbrzcrcx8_crc_algo_list[_clbrzcrcx8_fuzz_random(random_state) % clbrzcrcx8_crc_algo_list_size];
+		}
+		while(_clbrzcrcx8_fuzz_supported(crc_configurations[algo_index]) != 1);
+	}
+
+	byte_data = memmove(&fuzz_buffer[_clbrzcrcx8_fuzz_random(random_state) % FUZZ_ALIGNMENT_SLACK], source_data, data_len);
+
+	clbrzcrcx8_calculate_crc_multi(crc_configurations, crcs, algo_count, byte_data, data_len);
+
+	split_index = (data_len == 0) ? 0 : (_clbrzcrcx8_fuzz_random(random_state) % (data_len + 1));
+	for (algo_index = 0; algo_index < algo_count; algo_index++)
+	{
+		clbrzcrcx8_init_crc_state(&crc_states[algo_index], crc_configurations[algo_index]);
+	}
+	clbrzcrcx8_update_crc_states(crc_states, algo_count, byte_data, split_index);
+	clbrzcrcx8_update_crc_states(crc_states, algo_count, byte_data + split_index, data_len - split_index);
+
+	for (algo_index = 0; algo_index < algo_count; algo_index++)
+	{
+		expected_crc = _clbrzcrcx8_fuzz_reference(crc_configurations[algo_index], byte_data, data_len);
+		if(crcs[algo_index] != expected_crc)
+		{
+			return _clbrzcrcx8_fuzz_report(crc_configurations[algo_index], "multi", data_len, expected_crc, crcs[algo_index]);
+		}
+		if( (clbrzcrcx8_finalize_crc_state(&crc_states[algo_index]) != expected_crc) || (crc_states[algo_index].byte_count != data_len) )
+		{
+			return _clbrzcrcx8_fuzz_report(crc_configurations[algo_index], "multi states", data_len, expected_crc,
+											clbrzcrcx8_finalize_crc_state(&crc_states[algo_index]));
+		}
+	}
+
+	return 1; // ok.
+}
+
+
+// bulk reflect against the byte-wise reflect, same random alignment treatment.
+static int _clbrzcrcx8_fuzz_check_reflect(const uint8_t* source_data, size_t data_len, uint32_t* random_state)
+{
+	uint8_t* reflected_data = &fuzz_buffer[_clbrzcrcx8_fuzz_random(random_state) % FUZZ_ALIGNMENT_SLACK];
+	size_t byte_index;
+
+	clbrzcrcx8_reflect_buffer(reflected_data, source_data, data_len);
+	for (byte_index = 0; byte_index < data_len; byte_index++)
+	{
+		if(reflected_data[byte_index] != (uint8_t)_clbrzcrcx8_reflect_bitwise(source_data[byte_index], 8))
+		{
+			printf("reflect_buffer mismatch, len %u at %u\n", (unsigned int)data_len, (unsigned int)byte_index);
+			return 0;
+		}
+	}
+
+	return 1; // ok.
+}
+
+#endif // #if defined(CLBRZCRCX8_ENABLE_CRC_FUZZ_TEST) || defined(CLBRZCRCX8_ENABLE_CRC_FUZZER)
+
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_FUZZ_TEST
+
+#ifndef FUZZ_TEST_ROUNDS
+#define FUZZ_TEST_ROUNDS			200				// per algorithm
+#endif // #ifndef FUZZ_TEST_ROUNDS
+
+static uint8_t fuzz_source[FUZZ_MAX_DATA_SIZE];
+
+
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+#define FUZZ_CALIBRATION_FILE		"clbrz_crcx8_calibration_test.bin"
+#define FUZZ_CALIBRATION_ALGOS		32			// the fuzz build has as many calibration slots (see Makefile)
+
+// calibrate everything, then the plans must survive a save/load, and a damaged file must be refused.
+static int _clbrzcrcx8_fuzz_check_calibration()
+{
+	CLBRZCRCx8_CalibrationPlan_t plans[FUZZ_CALIBRATION_ALGOS];
+	CLBRZCRCx8_CalibrationPlan_t loaded_plan;
+	CLBRZCRCx8_CalibrationPlan_t other_plan;
+	FILE* calibration_file;
+	long damaged_offset;
+	int damaged_byte;
+	int algo_index;
+	int failed = 0;
+	uint64_t start_ns;
+
+	if(clbrzcrcx8_crc_algo_list_size > FUZZ_CALIBRATION_ALGOS)
+	{
+		printf("calibration check : SKIP, more algorithms than calibration slots\n");
+		return 1;
+	}
+
+	start_ns = _clbrzcrcx8_calibration_now_ns();
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		if(_clbrzcrcx8_find_table_set(clbrzcrcx8_crc_algo_list[algo_index].polynomial, clbrzcrcx8_crc_algo_list[algo_index].width,
+										clbrzcrcx8_crc_algo_list[algo_index].reflect_input) == NULL)
+		{
+			continue; // table cache full, the crcs of it run bitwise and there is nothing to plan.
+		}
+		if(clbrzcrcx8_calibrate(&clbrzcrcx8_crc_algo_list[algo_index], NULL) != 1)
+		{
+			printf("%-16s : calibration FAIL\n", clbrzcrcx8_crc_algo_list[algo_index].name);
+			return 0;
+		}
+	}
+	printf("calibration of %d algorithms : %.1f ms\n", clbrzcrcx8_crc_algo_list_size, (double)(_clbrzcrcx8_calibration_now_ns() - start_ns) / 1e6);
+
+	// algorithms that only differ in init/xorout share a plan, the last calibration of it counts.
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		if(clbrzcrcx8_get_calibration(&clbrzcrcx8_crc_algo_list[algo_index], &plans[algo_index]) != 1)
+		{
+			plans[algo_index].width = 0;	// not calibrated
+		}
+	}
+
+	if(clbrzcrcx8_save_calibration(FUZZ_CALIBRATION_FILE) != 1)
+	{
+		printf("calibration save FAIL\n");
+		return 0;
+	}
+
+	// something else in the plans, the file has to bring the calibrated ones back.
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		if(plans[algo_index].width == 0)
+		{
+			continue;
+		}
+		other_plan = plans[algo_index];
+		memset(other_plan.engines, CLBRZCRCX8_ENGINE_BITWISE, sizeof(other_plan.engines));
+		clbrzcrcx8_set_calibration(&other_plan);
+	}
+
+	if(clbrzcrcx8_load_calibration(FUZZ_CALIBRATION_FILE) != 1)
+	{
+		printf("calibration load FAIL\n");
+		failed++;
+	}
+	for (algo_index = 0; (algo_index < clbrzcrcx8_crc_algo_list_size) && (failed == 0); algo_index++)
+	{
+		if(plans[algo_index].width == 0)
+		{
+			continue;
+		}
+		if( (clbrzcrcx8_get_calibration(&clbrzcrcx8_crc_algo_list[algo_index], &loaded_plan) != 1) ||
+			(memcmp(loaded_plan.engines, plans[algo_index].engines, sizeof(loaded_plan.engines)) != 0) )
+		{
+			printf("%-16s : calibration load gave another plan, FAIL\n", clbrzcrcx8_crc_algo_list[algo_index].name);
+			failed++;
+		}
+	}
+
+	// one bit off in the middle of the file.
+	calibration_file = fopen(FUZZ_CALIBRATION_FILE, "r+b");
+	if(calibration_file != NULL)
+	{
+		fseek(calibration_file, 0, SEEK_END);
+		damaged_offset = ftell(calibration_file) / 2;
+		fseek(calibration_file, damaged_offset, SEEK_SET);
+		damaged_byte = fgetc(calibration_file);
+		fseek(calibration_file, damaged_offset, SEEK_SET);
+		fputc(damaged_byte ^ 0x10, calibration_file);
+		fclose(calibration_file);
+	}
+	if(clbrzcrcx8_load_calibration(FUZZ_CALIBRATION_FILE) != 0)
+	{
+		printf("damaged calibration file loaded, FAIL\n");
+		failed++;
+	}
+
+	remove(FUZZ_CALIBRATION_FILE);
+
+	return (failed == 0) ? 1 : 0;
+}
+
+
+#if !defined(__STDC_NO_ATOMICS__) && (defined(__unix__) || defined(__APPLE__))
+#include <pthread.h>
+
+#define FUZZ_REPLAN_ROUNDS			2000
+#define FUZZ_REPLAN_MIN_REPLANS		100			// crcs keep running until the plan was replaced this often
+
+static atomic_uint fuzz_replan_stop;
+static atomic_uint fuzz_replan_count;
+
+
+static void* _clbrzcrcx8_fuzz_replan_thread(void* plan_arg)
+{
+	CLBRZCRCx8_CalibrationPlan_t plan = *(const CLBRZCRCx8_CalibrationPlan_t*)plan_arg;
+	uint32_t random_state = 0x2545f491;
+	unsigned int size_class;
+
+	while(atomic_load_explicit(&fuzz_replan_stop, memory_order_relaxed) == 0)
+	{
+		for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+		{
+			random_state ^= random_state << 13;
+			random_state ^= random_state >> 17;
+			random_state ^= random_state << 5;
+			plan.engines[size_class] = (uint8_t)(random_state % CALIBRATION_ENGINE_COUNT);
+		}
+		clbrzcrcx8_set_calibration(&plan);
+		atomic_fetch_add_explicit(&fuzz_replan_count, 1, memory_order_relaxed);
+	}
+
+	return NULL;
+}
+
+
+// plans replaced on another thread while crcs of the configuration run : the crcs must not change (and, under
+// ThreadSanitizer, there must be no race on the plan).
+static int _clbrzcrcx8_fuzz_check_replan()
+{
+	CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr = &clbrzcrcx8_crc_algo_list[0];
+	CLBRZCRCx8_CalibrationPlan_t plan;
+	pthread_t replan_thread;
+	uint32_t expected_crcs[CLBRZCRCX8_CALIBRATION_SIZE_CLASSES];
+	unsigned int size_class;
+	int round_index;
+	int failed = 0;
+
+	if(clbrzcrcx8_get_calibration(crc_configuration_ptr, &plan) != 1)
+	{
+		return 1; // no tables for it in this build.
+	}
+	for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+	{
+		expected_crcs[size_class] = clbrzcrcx8_calculate_crc(crc_configuration_ptr, fuzz_source, (size_t)1 << size_class);
+	}
+
+	atomic_store(&fuzz_replan_stop, 0);
+	atomic_store(&fuzz_replan_count, 0);
+	if(pthread_create(&replan_thread, NULL, _clbrzcrcx8_fuzz_replan_thread, &plan) != 0)
+	{
+		return 1;
+	}
+	for (round_index = 0;
+		 ((round_index < FUZZ_REPLAN_ROUNDS) || (atomic_load_explicit(&fuzz_replan_count, memory_order_relaxed) < FUZZ_REPLAN_MIN_REPLANS)) &&
+		 (failed == 0);
+		 round_index++)
+	{
+		size_class = (unsigned int)round_index % CLBRZCRCX8_CALIBRATION_SIZE_CLASSES;
+		if(clbrzcrcx8_calculate_crc(crc_configuration_ptr, fuzz_source, (size_t)1 << size_class) != expected_crcs[size_class])
+		{
+			printf("%-16s : crc changed while the plan was replaced, FAIL\n", crc_configuration_ptr->name);
+			failed++;
+		}
+	}
+	atomic_store(&fuzz_replan_stop, 1);
+	pthread_join(replan_thread, NULL);
+
+	return (failed == 0) ? 1 : 0;
+}
+#endif // #if !defined(__STDC_NO_ATOMICS__) && (defined(__unix__) || defined(__APPLE__))
+
+
+// any plan has to give the same crcs, so every round runs under a random one.
+static void _clbrzcrcx8_fuzz_random_plan(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, uint32_t* random_state)
+{
+	CLBRZCRCx8_CalibrationPlan_t plan;
+	unsigned int size_class;
+
+	plan.polynomial = crc_configuration_ptr->polynomial;
+	plan.width = crc_configuration_ptr->width;
+	plan.reflect_input = crc_configuration_ptr->reflect_input;
+	for (size_class = 0; size_class < CLBRZCRCX8_CALIBRATION_SIZE_CLASSES; size_class++)
+	{
+		plan.engines[size_class] = (uint8_t)(_clbrzcrcx8_fuzz_random(random_state) % CALIBRATION_ENGINE_COUNT);
+	}
+
+	clbrzcrcx8_set_calibration(&plan);
+}
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+
+#if defined(CLBRZCRCX8_ENABLE_PARALLEL) && defined(CLBRZCRCX8_HAVE_NUMA)
+#include <sys/stat.h>
+
+#define FUZZ_NUMA_DIR				"clbrz_crcx8_numa_test"
+
+static void _clbrzcrcx8_fuzz_write_file(const char* path, const char* text)
+{
+	FILE* text_file = fopen(path, "w");
+
+	if(text_file != NULL)
+	{
+		fputs(text, text_file);
+		fclose(text_file);
+	}
+}
+
+
+// a fake 2 node host : the workers pin themselves, one of them on the caller's thread, whose affinity must be the same afterwards.
+// node 0 is the first cpu the caller may run on, node 1 the last, so with 2 or more cpus the pinning is visible.
+static int _clbrzcrcx8_fuzz_check_parallel_affinity()
+{
+	cpu_set_t caller_cpus;
+	cpu_set_t caller_cpus_after;
+	char cpu_text[16];
+	int first_cpu = -1;
+	int last_cpu = -1;
+	int cpu;
+	uint32_t calculated_crc;
+	uint32_t expected_crc;
+	int failed = 0;
+
+	if(pthread_getaffinity_np(pthread_self(), sizeof(caller_cpus), &caller_cpus) != 0)
+	{
+		printf("parallel affinity check : SKIP, no affinity\n");
+		return 1;
+	}
+	for (cpu = 0; cpu < CPU_SETSIZE; cpu++)
+	{
+		if(CPU_ISSET(cpu, &caller_cpus))
+		{
+			first_cpu = (first_cpu < 0) ? cpu : first_cpu;
+			last_cpu = cpu;
+		}
+	}
+
+	mkdir(FUZZ_NUMA_DIR, 0700);
+	mkdir(FUZZ_NUMA_DIR "/node0", 0700);
+	mkdir(FUZZ_NUMA_DIR "/node1", 0700);
+	_clbrzcrcx8_fuzz_write_file(FUZZ_NUMA_DIR "/online", "0-1\n");
+	snprintf(cpu_text, sizeof(cpu_text), "%d\n", first_cpu);
+	_clbrzcrcx8_fuzz_write_file(FUZZ_NUMA_DIR "/node0/cpulist", cpu_text);
+	snprintf(cpu_text, sizeof(cpu_text), "%d\n", last_cpu);
+	_clbrzcrcx8_fuzz_write_file(FUZZ_NUMA_DIR "/node1/cpulist", cpu_text);
+
+	parallel_node_dir = FUZZ_NUMA_DIR;
+	calculated_crc = clbrzcrcx8_calculate_crc_parallel(&clbrzcrcx8_crc_algo_list[0], fuzz_source, FUZZ_MAX_DATA_SIZE, 4);
+	parallel_node_dir = "/sys/devices/system/node";
+
+	expected_crc = clbrzcrcx8_calculate_crc(&clbrzcrcx8_crc_algo_list[0], fuzz_source, FUZZ_MAX_DATA_SIZE);
+	if(calculated_crc != expected_crc)
+	{
+		printf("parallel on 2 nodes : crc 0x%08x, expected 0x%08x, FAIL\n", (unsigned int)calculated_crc, (unsigned int)expected_crc);
+		failed++;
+	}
+	if( (pthread_getaffinity_np(pthread_self(), sizeof(caller_cpus_after), &caller_cpus_after) != 0) ||
+		!CPU_EQUAL(&caller_cpus, &caller_cpus_after) )
+	{
+		printf("parallel on 2 nodes left the caller pinned, FAIL\n");
+		failed++;
+	}
+
+	remove(FUZZ_NUMA_DIR "/node1/cpulist");
+	remove(FUZZ_NUMA_DIR "/node0/cpulist");
+	remove(FUZZ_NUMA_DIR "/online");
+	remove(FUZZ_NUMA_DIR "/node1");
+	remove(FUZZ_NUMA_DIR "/node0");
+	remove(FUZZ_NUMA_DIR);
+
+	return (failed == 0) ? 1 : 0;
+}
+#endif // #if defined(CLBRZCRCX8_ENABLE_PARALLEL) && defined(CLBRZCRCX8_HAVE_NUMA)
+
+
+// usage : clbrz_crcx8_fuzz_test [seed]
+int main(int argc, char* argv[])
+{
+	uint32_t seed = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 0x12345678;
+	uint32_t random_state;
+	size_t data_len;
+	size_t byte_index;
+	int algo_index;
+	int round_index;
+	int failed = 0;
+
+	if(seed == 0)
+	{
+		seed = 1;	// xorshift stays at 0
+	}
+	printf("fuzz test seed 0x%08x, %d rounds per algorithm\n\n", (unsigned int)seed, FUZZ_TEST_ROUNDS);
+
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+	if(_clbrzcrcx8_fuzz_check_calibration() != 1)
+	{
+		failed++;
+	}
+#if !defined(__STDC_NO_ATOMICS__) && (defined(__unix__) || defined(__APPLE__))
+	if(_clbrzcrcx8_fuzz_check_replan() != 1)
+	{
+		failed++;
+	}
+#endif // #if !defined(__STDC_NO_ATOMICS__) && (defined(__unix__) || defined(__APPLE__))
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+#if defined(CLBRZCRCX8_ENABLE_PARALLEL) && defined(CLBRZCRCX8_HAVE_NUMA)
+	if(_clbrzcrcx8_fuzz_check_parallel_affinity() != 1)
+	{
+		failed++;
+	}
+#endif // #if defined(CLBRZCRCX8_ENABLE_PARALLEL) && defined(CLBRZCRCX8_HAVE_NUMA)
+
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		random_state = seed ^ (uint32_t)(algo_index * 0x9e3779b1UL);
+
+		if(_clbrzcrcx8_fuzz_supported(&clbrzcrcx8_crc_algo_list[algo_index]) != 1)
+		{
+			printf("%-16s : SKIP, no table for it in this build\n", clbrzcrcx8_crc_algo_list[algo_index].name);
+			continue;
+		}
+
+		for (round_index = 0; (round_index < FUZZ_TEST_ROUNDS) && (failed == 0); round_index++)
+		{
+			// mostly short lengths, where the head/tail and lane edge cases are, now and then up to 64KiB.
+			switch(_clbrzcrcx8_fuzz_random(&random_state) % 4)
+			{
+				case 0:		data_len = _clbrzcrcx8_fuzz_random(&random_state) % 17;							break;
+				case 1:		data_len = _clbrzcrcx8_fuzz_random(&random_state) % 257;						break;
+				case 2:		data_len = _clbrzcrcx8_fuzz_random(&random_state) % 4097;						break;
+				default:	data_len = _clbrzcrcx8_fuzz_random(&random_state) % (FUZZ_MAX_DATA_SIZE + 1);	break;
+			}
+			for (byte_index = 0; byte_index < data_len; byte_index++)
+			{
+				fuzz_source[byte_index] = (uint8_t)_clbrzcrcx8_fuzz_random(&random_state);
+			}
+
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+			_clbrzcrcx8_fuzz_random_plan(&clbrzcrcx8_crc_algo_list[algo_index], &random_state);
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+			if( (_clbrzcrcx8_fuzz_check(&clbrzcrcx8_crc_algo_list[algo_index], fuzz_source, data_len, &random_state) != 1) ||
+				(_clbrzcrcx8_fuzz_check_reflect(fuzz_source, data_len, &random_state) != 1) ||
+				(_clbrzcrcx8_fuzz_check_multi(fuzz_source, data_len, &random_state) != 1) )
+			{
+				printf("%-16s : FAIL in round %d, rerun with seed 0x%08x\n",
+						clbrzcrcx8_crc_algo_list[algo_index].name, round_index, (unsigned int)seed);
+				failed++;
+			}
+		}
+
+		if(failed == 0)
+		{
+			printf("%-16s : PASS\n", clbrzcrcx8_crc_algo_list[algo_index].name);
+		}
+	}
+
+	return (failed == 0) ? 0 : 1;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_FUZZ_TEST
+
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_FUZZER
+
+// first byte : algorithm and split/alignment seed, the rest : the data. a mismatch aborts, which libFuzzer reports.
+int LLVMFuzzerTestOneInput(const uint8_t* fuzz_data, size_t fuzz_data_size)
+{
+	uint32_t random_state;
+
+	if((fuzz_data_size == 0) || (fuzz_data_size - 1 > FUZZ_MAX_DATA_SIZE))
+	{
+		return 0;
+	}
+	if(_clbrzcrcx8_fuzz_supported(&clbrzcrcx8_crc_algo_list[fuzz_data[0] % clbrzcrcx8_crc_algo_list_size]) != 1)
+	{
+		return 0;
+	}
+	random_state = 0x9e3779b1UL ^ ((uint32_t)fuzz_data[0] << 8) ^ (uint32_t)fuzz_data_size;
+
+	if( (_clbrzcrcx8_fuzz_check(&clbrzcrcx8_crc_algo_list[fuzz_data[0] % clbrzcrcx8_crc_algo_list_size],
+								fuzz_data + 1, fuzz_data_size - 1, &random_state) != 1) ||
+		(_clbrzcrcx8_fuzz_check_reflect(fuzz_data + 1, fuzz_data_size - 1, &random_state) != 1) ||
+		(_clbrzcrcx8_fuzz_check_multi(fuzz_data + 1, fuzz_data_size - 1, &random_state) != 1) )
+	{
+		abort();
+	}
+
+	return 0;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_FUZZER
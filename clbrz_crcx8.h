@@ -1,149 +1,307 @@
-/*
- ============================================================================
-
- ██████╗██████╗  ██████╗██╗  ██╗ █████╗
-██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
-██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
-██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
-╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
- ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
-
-	Author      : clbrz
-	Version     : v1.3
-
-    This is free and unencumbered software released into the public domain.
-
-    Anyone is free to copy, modify, publish, use, compile, sell, or
-    distribute this software, either in source code form or as a compiled
-    binary, for any purpose, commercial or non-commercial, and by any
-    means.
-
-    In jurisdictions that recognize copyright laws, the author or authors
-    of this software dedicate any and all copyright interest in the
-    software to the public domain. We make this dedication for the benefit
-    of the public at large and to the detriment of our heirs and
-    successors. We intend this dedication to be an overt act of
-    relinquishment in perpetuity of all present and future rights to this
-    software under copyright law.
-
-    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
-    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
-    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
-    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
-    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
-    OTHER DEALINGS IN THE SOFTWARE.
-
-    For more information, please refer to <http://unlicense.org/>
-
-	Description : We wanted a self-understood, preferably self-implemented crc code, that we can use freely.
-				 After a lot of hand-wringing and hair pulling, we finally understood the general
-				 class of CRC algorithms for various widths, and the implementation level tricks as well.
-				 REFERENCES:
-				 >> theory, background:
-					 http://www.zlib.net/crc_v3.txt (Ross Williams)
-				 >> practical, implementation oriented:
-					 http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html (Bastian Molkenthin)
-					 check out the references section specially.
-				 >> handbook/reference for current CRC algos:
-					 http://reveng.sourceforge.net/crc-catalogue/ (Greg Cook)
-				 >> some more explanations:
-					 http://www.alterawiki.com/wiki/Practical_CRC_Usage
-				 Thanks to these guys, I finally have a working and clearly understood crc implementation.
-				 the goal is to target any crc-8/crc-16/crc-32 algorithms out there, leaving out the exotic crc widths (12/24/31...)
-				 and to ensure that all the common options can be changed on the go, to keep it flexible.
-				 this is all public domain code.
-
-	credits: http://patorjk.com/software/taag/#p=display&h=0&v=1&f=ANSI%20Shadow&t=crcx8
-
-	usage :
-	(1) decide if you want to use TABLE -> yes if you don't know, leave the CLBRZCRCX8_USE_TABLE_FOR_CRC defined
-	(3) create the CRCTypeDescriptor_t instance, with the parameters: name width poly init xorout refin refout check_value
-	name is an optional string to describe this crc configuration
-	check_value is optional, and is the result of the CRC algo running over the string: "123456789\0"
-	if valid check_value is passed in, then crc_self_test() can be used to check if this algo is ok.
-	(2) call init_crc() with the CRCTypeDescriptor_t instance address.
-	(3) call calculate_crc_chunk() as many times on the data stream, each call returns an "intermediate crc" if you would like to use this
-	(4) call finalize_crc(), returns the calculated crc.
-
-	To repeat crc on another set of data with the same crc config:
-	(1) call reset_crc()
-	(2) follow steps (3) and (4) as above
-
- ============================================================================
- */
-
-#ifndef CLBRZ_CRCX8_H_
-#define CLBRZ_CRCX8_H_
-
-#ifdef __cplusplus
-extern "C" {
-#endif // #ifdef __cplusplus
-
-#include <stdint.h>
-
-
-#define CLBRZCRCX8_USE_TABLE_FOR_CRC			// disable to remove table usage.
-//#define CLBRZCRCX8_ENABLE_TABLE_GENERATION		// disable to remove the on demand table generation/print api (ENSURE UPDATE OF FIXED TABLE !!!)
-//#define CLBRZCRCX8_ENABLE_CRC_TEST				// disable to remove the CRC 8/16/32 tests
-//#define CLBRZCRCX8_ENABLE_CRC_SELF_TEST			// disable to remove the self test API.
-//#define CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE		// disable to remove the self residue calculation API.
-
-
-typedef struct _crcAlgoTypeDescriptor
-{
-	const char* name;
-	uint8_t 	width;				// 8/16/32
-	uint32_t 	polynomial;			// can actually be uint8_t/uint16_t/uint32_t
-	uint32_t 	initial_value;		// can actually be uint8_t/uint16_t/uint32_t
-	uint32_t 	final_xor_value;	// can actually be uint8_t/uint16_t/uint32_t
-	uint8_t 	reflect_input;
-	uint8_t 	reflect_output;
-	uint32_t	check_value;					// CRC when run against "123456789\0"
-	uint32_t	residue;						// constant value = CRC (DATA + CRC_OF_DATA)
-
-} CLBRZCRCx8_CRCTypeDescriptor_t;
-
-extern int clbrzcrcx8_crc_algo_list_size;
-extern CLBRZCRCx8_CRCTypeDescriptor_t clbrzcrcx8_crc_algo_list[];
-
-
-uint32_t clbrzcrcx8_reflect(uint32_t value, uint8_t num_bits_to_reflect);
-
-#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-void clbrzcrcx8_generate_crc_table();
-void clbrzcrcx8_print_crc_table();
-#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
-
-// set the CRC config to be used and generate table is enabled.
-void clbrzcrcx8_init_crc(CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr);
-
-// calculate CRC on chunk, CRC is carried over from previous calculation.
-uint32_t clbrzcrcx8_calculate_crc_chunk(uint8_t* byte_data, int32_t data_len);
-
-// reset CRC for fresh calculation, CRC configuration is unchanged.
-uint32_t clbrzcrcx8_reset_crc_chunk();
-
-// return final CRC value, call after all chunks are processed. applies reflect_out and final_xor.
-uint32_t clbrzcrcx8_finalize_crc();
-
-#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
-// run the self-test -> calculates CRC of string: "123456789" and should be equal to check_value
-int clbrzcrcx8_self_test();
-#endif // CLBRZCRCX8_ENABLE_CRC_SELF_TEST
-
-#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
-// runs the CRC over a few data points, and calculates residue, which should be the same for any data point.
-uint32_t clbrzcrcx8_calculate_self_residue();
-#endif // CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
-
-#ifdef CLBRZCRCX8_ENABLE_CRC_TEST
-int clbrzcrcx8_test();
-#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_TEST
-
-
-#ifdef __cplusplus
-}
-#endif // #ifdef __cplusplus
-
-#endif /* CLBRZ_CRCX8_H_ */
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+    This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+
+	Description : We wanted a self-understood, preferably self-implemented crc code, that we can use freely.
+				 After a lot of hand-wringing and hair pulling, we finally understood the general
+				 class of CRC algorithms for various widths, and the implementation level tricks as well.
+				 REFERENCES:
+				 >> theory, background:
+					 http://www.zlib.net/crc_v3.txt (Ross Williams)
+				 >> practical, implementation oriented:
+					 http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html (Bastian Molkenthin)
+					 check out the references section specially.
+				 >> handbook/reference for current CRC algos:
+					 http://reveng.sourceforge.net/crc-catalogue/ (Greg Cook)
+				 >> some more explanations:
+					 http://www.alterawiki.com/wiki/Practical_CRC_Usage
+				 Thanks to these guys, I finally have a working and clearly understood crc implementation.
+				 the goal is to target any crc-8/crc-16/crc-32 algorithms out there, leaving out the exotic crc widths (12/24/31...)
+				 and to ensure that all the common options can be changed on the go, to keep it flexible.
+				 this is all public domain code.
+
+	credits: http://patorjk.com/software/taag/#p=display&h=0&v=1&f=ANSI%20Shadow&t=crcx8
+
+	usage :
+	(1) decide if you want to use TABLE -> yes if you don't know, leave the CLBRZCRCX8_USE_TABLE_FOR_CRC defined
+	(3) create the CRCTypeDescriptor_t instance, with the parameters: name width poly init xorout refin refout check_value
+	name is an optional string to describe this crc configuration
+	check_value is optional, and is the result of the CRC algo running over the string: "123456789\0"
+	if valid check_value is passed in, then crc_self_test() can be used to check if this algo is ok.
+	(2) call init_crc() with the CRCTypeDescriptor_t instance address.
+	(3) call calculate_crc_chunk() as many times on the data stream, each call returns an "intermediate crc" if you would like to use this
+	(4) call finalize_crc(), returns the calculated crc.
+
+	To repeat crc on another set of data with the same crc config:
+	(1) call reset_crc()
+	(2) follow steps (3) and (4) as above
+
+ ============================================================================
+ */
+
+#ifndef CLBRZ_CRCX8_H_
+#define CLBRZ_CRCX8_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+#define CLBRZCRCX8_USE_TABLE_FOR_CRC			// disable to remove table usage.
+#define CLBRZCRCX8_USE_SIMD_FOR_CRC				// disable to remove the x86 SIMD (AVX2, detected at runtime) batch engine and bulk reflect.
+#define CLBRZCRCX8_ENABLE_SCRUB					// disable to remove the scrub api (prefetch, non-temporal hints, rate limit for cold data)
+//#define CLBRZCRCX8_ENABLE_TABLE_GENERATION		// disable to remove the on demand table generation/print api (ENSURE UPDATE OF FIXED TABLE !!!)
+													// tables are generated lazily, once per (poly, width, refin), and shared read-only across threads.
+													// tunables: CLBRZCRCX8_TABLE_CACHE_SLOTS (8), CLBRZCRCX8_SLICING_DEPTH (8, 4 or 1)
+//#define CLBRZCRCX8_USE_GENERATED_TABLES			// enable to use the const tables generated at build time (clbrz_crcx8_tables.inc, see Makefile)
+//#define CLBRZCRCX8_ENABLE_PARALLEL				// enable for the multi-threaded, NUMA aware crc of large buffers (needs pthreads)
+													// CLBRZCRCX8_PARALLEL_MIN_SEGMENT : bytes per thread at least, default 1 MiB
+//#define CLBRZCRCX8_USE_MULTIVERSIONING			// enable to build the scalar engines once per x86-64 level (v2 SSE4.2, v3 AVX2/BMI2, v4 AVX-512),
+													// the loader picks the best one for the host (gcc/clang target_clones, ifunc, see Makefile)
+//#define CLBRZCRCX8_ENABLE_CALIBRATION			// enable to time the engines per size class at start-up and dispatch by length (needs table sets)
+													// CLBRZCRCX8_CALIBRATION_SLOTS : calibrated (poly, width, refin) at most, default 16
+//#define CLBRZCRCX8_ENABLE_CRC_TEST				// disable to remove the CRC 8/16/32 tests
+//#define CLBRZCRCX8_ENABLE_CRC_SELF_TEST			// disable to remove the self test API.
+//#define CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE		// disable to remove the self residue calculation API.
+
+
+typedef struct _crcAlgoTypeDescriptor
+{
+	const char* name;
+	uint8_t 	width;				// 8/16/32
+	uint32_t 	polynomial;			// can actually be uint8_t/uint16_t/uint32_t
+	uint32_t 	initial_value;		// can actually be uint8_t/uint16_t/uint32_t
+	uint32_t 	final_xor_value;	// can actually be uint8_t/uint16_t/uint32_t
+	uint8_t 	reflect_input;
+	uint8_t 	reflect_output;
+	uint32_t	check_value;					// CRC when run against "123456789\0"
+	uint32_t	residue;						// constant value = CRC (DATA + CRC_OF_DATA)
+
+} CLBRZCRCx8_CRCTypeDescriptor_t;
+
+extern int clbrzcrcx8_crc_algo_list_size;
+extern CLBRZCRCx8_CRCTypeDescriptor_t clbrzcrcx8_crc_algo_list[];
+
+
+// bottom num_bits_to_reflect bits of value reflected, the bits above them are unchanged.
+uint32_t clbrzcrcx8_reflect(uint32_t value, uint8_t num_bits_to_reflect);
+
+// bit order of every byte reversed (LSB first <-> MSB first), byte order kept. destination may be the source.
+void clbrzcrcx8_reflect_buffer(void* destination, const void* source, size_t data_len);
+
+#ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+void clbrzcrcx8_generate_crc_table();
+void clbrzcrcx8_print_crc_table();
+#endif // #ifdef CLBRZCRCX8_ENABLE_TABLE_GENERATION
+
+// set the CRC config to be used and generate table is enabled.
+void clbrzcrcx8_init_crc(CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr);
+
+// calculate CRC on chunk, CRC is carried over from previous calculation.
+uint32_t clbrzcrcx8_calculate_crc_chunk(uint8_t* byte_data, int32_t data_len);
+
+// same as calculate_crc_chunk(), for any buffer and any length (> 4GiB is fine), the data is not modified.
+uint32_t clbrzcrcx8_calculate_crc_buffer(const void* data, size_t data_len);
+
+// reset CRC for fresh calculation, CRC configuration is unchanged.
+uint32_t clbrzcrcx8_reset_crc_chunk();
+
+// return final CRC value, call after all chunks are processed. applies reflect_out and final_xor.
+uint32_t clbrzcrcx8_finalize_crc();
+
+// calculate the complete CRC (init .. finalize) of record_count independent records, crcs[n] = CRC of records[n].
+// does not use or change the init_crc() state. many short records of one algorithm are run side by side in SIMD lanes.
+void clbrzcrcx8_calculate_crc_batch(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+									const uint8_t* const* records,
+									const size_t* record_lengths,
+									uint32_t* crcs,
+									size_t record_count);
+
+// the complete CRC (init .. finalize) of one buffer. does not use or change the init_crc() state, safe to call from any thread.
+uint32_t clbrzcrcx8_calculate_crc(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, const void* data, size_t data_len);
+
+// CRC of A followed by B, from the complete CRCs of A and B and the length of B alone, without the data.
+uint32_t clbrzcrcx8_combine_crc(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+								uint32_t crc_a,
+								uint32_t crc_b,
+								uint64_t length_b);
+
+// STATE : a running CRC as a plain value, for any number of streams at once (init_crc() has only one).
+// fixed size (32 bytes), no pointers : can be copied, suspended, moved to another thread or written out as is.
+typedef struct _crcState
+{
+	uint32_t	polynomial;
+	uint32_t	initial_value;
+	uint32_t	final_xor_value;
+	uint32_t	crc_register;		// the "intermediate crc", as calculate_crc_chunk() returns it
+	uint64_t	byte_count;			// bytes so far
+	uint8_t		width;
+	uint8_t		reflect_input;
+	uint8_t		reflect_output;
+	uint8_t		reserved[5];
+
+} CLBRZCRCx8_CRCState_t;
+
+// start a stream with this configuration, the descriptor is not needed afterwards.
+void clbrzcrcx8_init_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr, const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr);
+
+// same as calculate_crc_chunk(), on this stream only. returns the intermediate crc.
+uint32_t clbrzcrcx8_update_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr, const void* data, size_t data_len);
+
+// the CRC of the stream so far, the state is not changed : more data can follow.
+uint32_t clbrzcrcx8_finalize_crc_state(const CLBRZCRCx8_CRCState_t* crc_state_ptr);
+
+// back to the start of a stream, same configuration.
+void clbrzcrcx8_reset_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr);
+
+// CHECKPOINT : a state as a stable binary record, to resume a stream later, elsewhere, without the data so far.
+// CLBRZCRCX8_CHECKPOINT_SIZE bytes, little endian :
+// magic "CRCK", version (1), width, refin, refout, poly/init/xorout/register u32, byte count u64, CRC-32C of the rest u32.
+#define CLBRZCRCX8_CHECKPOINT_SIZE		36
+
+void clbrzcrcx8_export_crc_state(const CLBRZCRCx8_CRCState_t* crc_state_ptr, uint8_t checkpoint[CLBRZCRCX8_CHECKPOINT_SIZE]);
+
+// returns 1 if the checkpoint is intact (and, if crc_configuration_ptr is not NULL, of that configuration), 0 if not.
+int clbrzcrcx8_import_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr,
+								const uint8_t checkpoint[CLBRZCRCX8_CHECKPOINT_SIZE],
+								const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr);
+
+// append a range to the stream by its complete CRC and length (calculated elsewhere, or earlier), not by its data.
+uint32_t clbrzcrcx8_append_crc_state(CLBRZCRCx8_CRCState_t* crc_state_ptr, uint32_t range_crc, uint64_t range_length);
+
+// MULTI : several algorithms over the same data in one pass, memory is read once and the table lookups of the
+// algorithms are interleaved. crc_states : any number, each set up with init_crc_state(), can be different algorithms.
+void clbrzcrcx8_update_crc_states(CLBRZCRCx8_CRCState_t* crc_states, size_t state_count, const void* data, size_t data_len);
+
+// crcs[i] = clbrzcrcx8_calculate_crc(crc_configurations[i], data, data_len), for i in [0, algo_count), in one pass.
+void clbrzcrcx8_calculate_crc_multi(const CLBRZCRCx8_CRCTypeDescriptor_t* const* crc_configurations,
+									uint32_t* crcs,
+									size_t algo_count,
+									const void* data,
+									size_t data_len);
+
+#ifdef CLBRZCRCX8_ENABLE_PARALLEL
+// PARALLEL : one large buffer on thread_count threads (0 = one per online cpu), NUMA aware on linux, see the .c
+uint32_t clbrzcrcx8_calculate_crc_parallel(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+											const void* data,
+											size_t data_len,
+											unsigned int thread_count);
+#endif // #ifdef CLBRZCRCX8_ENABLE_PARALLEL
+
+#ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+// CALIBRATION : which engine is fastest depends on the length and on the cpu, calibrate() times them on this machine,
+// per size class (class n : lengths in [2^n, 2^(n+1)), the last class takes everything longer), and the single buffer
+// and streaming calls of that configuration then go through the winner for their length.
+#define CLBRZCRCX8_ENGINE_BITWISE				0	// no tables at all
+#define CLBRZCRCX8_ENGINE_TABLE					1	// one table lookup per byte
+#define CLBRZCRCX8_ENGINE_SLICING				2	// slicing-by-CLBRZCRCX8_SLICING_DEPTH (the default without a plan)
+
+#define CLBRZCRCX8_CALIBRATION_SIZE_CLASSES		14
+
+typedef struct _crcCalibrationPlan
+{
+	uint32_t	polynomial;		// masked to width
+	uint8_t		width;
+	uint8_t		reflect_input;
+	uint8_t		engines[CLBRZCRCX8_CALIBRATION_SIZE_CLASSES];	// CLBRZCRCX8_ENGINE_xxx per size class
+
+} CLBRZCRCx8_CalibrationPlan_t;
+
+// all of these return 1 if ok, 0 if not.
+// plans are meant to be set up at start-up : replacing one while other threads run crcs of that configuration is
+// safe (any engine gives the same crc), but they can use a mix of the old and the new plan for a while.
+
+// a few ms, plan_ptr can be NULL. 0 : no tables for the configuration, or no free plan slot.
+int clbrzcrcx8_calibrate(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, CLBRZCRCx8_CalibrationPlan_t* plan_ptr);
+
+// use a plan from elsewhere (a previous run, a fixed one for the target).
+int clbrzcrcx8_set_calibration(const CLBRZCRCx8_CalibrationPlan_t* plan_ptr);
+int clbrzcrcx8_get_calibration(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, CLBRZCRCx8_CalibrationPlan_t* plan_ptr);
+
+// all plans to/from a small binary file, so later runs skip the timing. load() refuses (returns 0) a missing or damaged
+// file, and a file written on another cpu model or build : calibrate and save again then.
+int clbrzcrcx8_save_calibration(const char* path);
+int clbrzcrcx8_load_calibration(const char* path);
+#endif // #ifdef CLBRZCRCX8_ENABLE_CALIBRATION
+
+#ifdef CLBRZCRCX8_ENABLE_SCRUB
+typedef struct _crcScrubConfig
+{
+	size_t		prefetch_distance;			// bytes ahead of the crc to prefetch, 0 = no prefetch
+	uint8_t		non_temporal;				// 1 = prefetch with the non-temporal hint, keeps the data out of the outer caches
+	uint64_t	rate_limit_bytes_per_sec;	// 0 = as fast as possible (rate limit needs POSIX clocks, ignored without them)
+
+	// rate limit state, carried over across scrub calls : set up by init_scrub(), do not touch.
+	uint64_t	budget_start_ns;
+	uint64_t	budget_bytes;
+
+} CLBRZCRCx8_ScrubConfig_t;
+
+// set up the scrub config, the rate limit starts counting from here.
+void clbrzcrcx8_init_scrub(CLBRZCRCx8_ScrubConfig_t* scrub_config_ptr,
+							size_t prefetch_distance,
+							uint8_t non_temporal,
+							uint64_t rate_limit_bytes_per_sec);
+
+// same as calculate_crc_buffer(), for data that is not going to be used again (verify passes over cold data) :
+// prefetch ahead, non-temporal hints, and sleeps as needed to stay under the rate limit.
+uint32_t clbrzcrcx8_calculate_crc_scrub(CLBRZCRCx8_ScrubConfig_t* scrub_config_ptr, const void* data, size_t data_len);
+#endif // #ifdef CLBRZCRCX8_ENABLE_SCRUB
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_TEST
+// run the self-test -> calculates CRC of string: "123456789" and should be equal to check_value
+int clbrzcrcx8_self_test();
+#endif // CLBRZCRCX8_ENABLE_CRC_SELF_TEST
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
+// runs the CRC over a few data points, and calculates residue, which should be the same for any data point.
+uint32_t clbrzcrcx8_calculate_self_residue();
+#endif // CLBRZCRCX8_ENABLE_CRC_SELF_RESIDUE
+
+#ifdef CLBRZCRCX8_ENABLE_CRC_TEST
+int clbrzcrcx8_test();
+#endif // #ifdef CLBRZCRCX8_ENABLE_CRC_TEST
+
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif /* CLBRZ_CRCX8_H_ */
@@ -0,0 +1,933 @@
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+    This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+
+
+	Description : block store, a block framed file format on top of clbrz_crcx8, see clbrz_crcx8_blockstore.h
+
+ ============================================================================
+ */
+
+// pread()/mmap()/pthreads are POSIX, make sure they are declared in strict ISO C builds too.
+#if !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "clbrz_crcx8_blockstore.h"
+#include "clbrz_crcx8_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+// the mapped reader can be used from any thread : the per block state is published with release/acquire.
+#ifndef __STDC_NO_ATOMICS__
+#include <stdatomic.h>
+typedef atomic_uchar block_state_t;
+#define BLOCK_STATE_LOAD(state_ptr)				atomic_load_explicit((state_ptr), memory_order_acquire)
+#define BLOCK_STATE_STORE(state_ptr, value)		atomic_store_explicit((state_ptr), (value), memory_order_release)
+#else
+typedef volatile unsigned char block_state_t;
+#define BLOCK_STATE_LOAD(state_ptr)				(*(state_ptr))
+#define BLOCK_STATE_STORE(state_ptr, value)		(*(state_ptr) = (value))
+#endif // #ifndef __STDC_NO_ATOMICS__
+
+enum
+{
+	BLOCK_NOT_CHECKED = 0,
+	BLOCK_GOOD,
+	BLOCK_BAD
+};
+
+#define INDEX_ENTRY_SIZE(width)			(((width) + 7) / 8)
+#define INDEX_INITIAL_CAPACITY			1024
+
+// trailer field offsets, see the header.
+#define TRAILER_MAGIC					0
+#define TRAILER_BLOCK_SIZE				8
+#define TRAILER_WIDTH					12
+#define TRAILER_REFLECT_INPUT			13
+#define TRAILER_REFLECT_OUTPUT			14
+#define TRAILER_POLYNOMIAL				16
+#define TRAILER_INITIAL_VALUE			20
+#define TRAILER_FINAL_XOR_VALUE			24
+#define TRAILER_DATA_LENGTH				28
+#define TRAILER_BLOCK_COUNT				36
+#define TRAILER_FILE_CRC				44
+#define TRAILER_INDEX_CRC				48
+#define TRAILER_TRAILER_CRC				52
+
+static const uint8_t blockstore_magic[8] = { 'C', 'L', 'B', 'R', 'Z', 'B', 'S', '1' };
+
+// pread() until done : it may return less than asked for.
+static int _clbrzcrcx8_blockstore_pread(int file_descriptor, void* data, size_t data_len, uint64_t file_offset)
+{
+	uint8_t* byte_data = (uint8_t*)data;
+	ssize_t read_len;
+
+	while(data_len > 0)
+	{
+		read_len = pread(file_descriptor, byte_data, data_len, (off_t)file_offset);
+		if(read_len < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if(read_len <= 0)
+		{
+			return CLBRZCRCX8_BLOCKSTORE_ERROR_IO;
+		}
+		byte_data += read_len;
+		data_len -= (size_t)read_len;
+		file_offset += (uint64_t)read_len;
+	}
+
+	return CLBRZCRCX8_BLOCKSTORE_OK;
+}
+
+
+
+// WRITER
+
+// one block (full, or the last short one) : crc, to the file, into the index, folded into the file crc.
+static int _clbrzcrcx8_blockstore_write_block(CLBRZCRCx8_BlockStoreWriter_t* writer_ptr, const uint8_t* block_data, uint32_t block_len)
+{
+	const size_t entry_size = INDEX_ENTRY_SIZE(writer_ptr->crc_configuration.width);
+	uint32_t block_crc = clbrzcrcx8_calculate_crc(&writer_ptr->crc_configuration, block_data, block_len);
+	uint8_t* grown_index;
+
+	if(fwrite(block_data, 1, block_len, writer_ptr->file) != block_len)
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_IO;
+	}
+
+	if(writer_ptr->block_count == writer_ptr->index_capacity)
+	{
+		grown_index = (uint8_t*)realloc(writer_ptr->index, (size_t)(writer_ptr->index_capacity * 2 * entry_size));
+		if(grown_index == NULL)
+		{
+			return CLBRZCRCX8_BLOCKSTORE_ERROR_MEMORY;
+		}
+		writer_ptr->index = grown_index;
+		writer_ptr->index_capacity *= 2;
+	}
+	_clbrzcrcx8_put_le(&writer_ptr->index[writer_ptr->block_count * entry_size], block_crc, (int)entry_size);
+
+	writer_ptr->file_crc = (writer_ptr->block_count == 0) ? block_crc :
+							clbrzcrcx8_combine_crc(&writer_ptr->crc_configuration, writer_ptr->file_crc, block_crc, block_len);
+	writer_ptr->block_count++;
+	writer_ptr->data_length += block_len;
+
+	return CLBRZCRCX8_BLOCKSTORE_OK;
+}
+
+
+static void _clbrzcrcx8_blockstore_free_writer(CLBRZCRCx8_BlockStoreWriter_t* writer_ptr)
+{
+	free(writer_ptr->block_buffer);
+	free(writer_ptr->index);
+	writer_ptr->block_buffer = NULL;
+	writer_ptr->index = NULL;
+	if(writer_ptr->file != NULL)
+	{
+		fclose(writer_ptr->file);
+		writer_ptr->file = NULL;
+	}
+}
+
+
+int clbrzcrcx8_blockstore_open_writer(CLBRZCRCx8_BlockStoreWriter_t* writer_ptr,
+										const char* file_path,
+										const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+										uint32_t block_size)
+{
+	if((writer_ptr == NULL) || (file_path == NULL) || (crc_configuration_ptr == NULL) || (block_size == 0) ||
+		(crc_configuration_ptr->width < 8) || (crc_configuration_ptr->width > 32))
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_ARGUMENT;
+	}
+
+	memset(writer_ptr, 0, sizeof(*writer_ptr));
+	writer_ptr->crc_configuration = *crc_configuration_ptr;
+	writer_ptr->block_size = block_size;
+	writer_ptr->index_capacity = INDEX_INITIAL_CAPACITY;
+	writer_ptr->block_buffer = (uint8_t*)malloc(block_size);
+	writer_ptr->index = (uint8_t*)malloc(INDEX_INITIAL_CAPACITY * INDEX_ENTRY_SIZE(crc_configuration_ptr->width));
+	if((writer_ptr->block_buffer == NULL) || (writer_ptr->index == NULL))
+	{
+		_clbrzcrcx8_blockstore_free_writer(writer_ptr);
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_MEMORY;
+	}
+
+	writer_ptr->file = fopen(file_path, "wb");
+	if(writer_ptr->file == NULL)
+	{
+		_clbrzcrcx8_blockstore_free_writer(writer_ptr);
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_IO;
+	}
+
+	return CLBRZCRCX8_BLOCKSTORE_OK;
+}
+
+
+int clbrzcrcx8_blockstore_write(CLBRZCRCx8_BlockStoreWriter_t* writer_ptr, const void* data, size_t data_len)
+{
+	const uint8_t* byte_data = (const uint8_t*)data;
+	size_t copy_len;
+	int result;
+
+	while(data_len > 0)
+	{
+		// whole blocks straight from the caller's buffer, no copy.
+		if((writer_ptr->block_fill == 0) && (data_len >= writer_ptr->block_size))
+		{
+			result = _clbrzcrcx8_blockstore_write_block(writer_ptr, byte_data, writer_ptr->block_size);
+			if(result != CLBRZCRCX8_BLOCKSTORE_OK)
+			{
+				return result;
+			}
+			byte_data += writer_ptr->block_size;
+			data_len -= writer_ptr->block_size;
+			continue;
+		}
+
+		copy_len = writer_ptr->block_size - writer_ptr->block_fill;
+		if(copy_len > data_len)
+		{
+			copy_len = data_len;
+		}
+		memcpy(&writer_ptr->block_buffer[writer_ptr->block_fill], byte_data, copy_len);
+		writer_ptr->block_fill += (uint32_t)copy_len;
+		byte_data += copy_len;
+		data_len -= copy_len;
+
+		if(writer_ptr->block_fill == writer_ptr->block_size)
+		{
+			result = _clbrzcrcx8_blockstore_write_block(writer_ptr, writer_ptr->block_buffer, writer_ptr->block_size);
+			writer_ptr->block_fill = 0;
+			if(result != CLBRZCRCX8_BLOCKSTORE_OK)
+			{
+				return result;
+			}
+		}
+	}
+
+	return CLBRZCRCX8_BLOCKSTORE_OK;
+}
+
+
+int clbrzcrcx8_blockstore_close_writer(CLBRZCRCx8_BlockStoreWriter_t* writer_ptr)
+{
+	uint8_t trailer[CLBRZCRCX8_BLOCKSTORE_TRAILER_SIZE];
+	size_t index_size;
+	int result = CLBRZCRCX8_BLOCKSTORE_OK;
+
+	if(writer_ptr->block_fill > 0)
+	{
+		result = _clbrzcrcx8_blockstore_write_block(writer_ptr, writer_ptr->block_buffer, writer_ptr->block_fill);
+		writer_ptr->block_fill = 0;
+	}
+	if(writer_ptr->block_count == 0)
+	{
+		writer_ptr->file_crc = clbrzcrcx8_calculate_crc(&writer_ptr->crc_configuration, writer_ptr->block_buffer, 0);
+	}
+
+	index_size = (size_t)(writer_ptr->block_count * INDEX_ENTRY_SIZE(writer_ptr->crc_configuration.width));
+
+	memset(trailer, 0, sizeof(trailer));
+	memcpy(&trailer[TRAILER_MAGIC], blockstore_magic, sizeof(blockstore_magic));
+	_clbrzcrcx8_put_le(&trailer[TRAILER_BLOCK_SIZE], writer_ptr->block_size, 4);
+	trailer[TRAILER_WIDTH] = writer_ptr->crc_configuration.width;
+	trailer[TRAILER_REFLECT_INPUT] = writer_ptr->crc_configuration.reflect_input;
+	trailer[TRAILER_REFLECT_OUTPUT] = writer_ptr->crc_configuration.reflect_output;
+	_clbrzcrcx8_put_le(&trailer[TRAILER_POLYNOMIAL], writer_ptr->crc_configuration.polynomial, 4);
+	_clbrzcrcx8_put_le(&trailer[TRAILER_INITIAL_VALUE], writer_ptr->crc_configuration.initial_value, 4);
+	_clbrzcrcx8_put_le(&trailer[TRAILER_FINAL_XOR_VALUE], writer_ptr->crc_configuration.final_xor_value, 4);
+	_clbrzcrcx8_put_le(&trailer[TRAILER_DATA_LENGTH], writer_ptr->data_length, 8);
+	_clbrzcrcx8_put_le(&trailer[TRAILER_BLOCK_COUNT], writer_ptr->block_count, 8);
+	_clbrzcrcx8_put_le(&trailer[TRAILER_FILE_CRC], writer_ptr->file_crc, 4);
+	_clbrzcrcx8_put_le(&trailer[TRAILER_INDEX_CRC],
+									clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, writer_ptr->index, index_size), 4);
+	_clbrzcrcx8_put_le(&trailer[TRAILER_TRAILER_CRC],
+									clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, trailer, TRAILER_TRAILER_CRC), 4);
+
+	if((result == CLBRZCRCX8_BLOCKSTORE_OK) &&
+		((fwrite(writer_ptr->index, 1, index_size, writer_ptr->file) != index_size) ||
+		 (fwrite(trailer, 1, sizeof(trailer), writer_ptr->file) != sizeof(trailer))))
+	{
+		result = CLBRZCRCX8_BLOCKSTORE_ERROR_IO;
+	}
+	if((fclose(writer_ptr->file) != 0) && (result == CLBRZCRCX8_BLOCKSTORE_OK))
+	{
+		result = CLBRZCRCX8_BLOCKSTORE_ERROR_IO;
+	}
+	writer_ptr->file = NULL;
+
+	_clbrzcrcx8_blockstore_free_writer(writer_ptr);
+
+	return result;
+}
+
+
+
+// READER
+
+static uint32_t _clbrzcrcx8_blockstore_block_length(const CLBRZCRCx8_BlockStoreReader_t* reader_ptr, uint64_t block_index)
+{
+	if(block_index + 1 < reader_ptr->block_count)
+	{
+		return reader_ptr->block_size;
+	}
+	return (uint32_t)(reader_ptr->data_length - block_index * reader_ptr->block_size);
+}
+
+
+static int _clbrzcrcx8_blockstore_check_block(const CLBRZCRCx8_BlockStoreReader_t* reader_ptr, uint64_t block_index, const uint8_t* block_data)
+{
+	uint32_t block_crc = clbrzcrcx8_calculate_crc(&reader_ptr->crc_configuration, block_data,
+													_clbrzcrcx8_blockstore_block_length(reader_ptr, block_index));
+
+	return (block_crc == reader_ptr->block_crcs[block_index]) ? CLBRZCRCX8_BLOCKSTORE_OK : CLBRZCRCX8_BLOCKSTORE_ERROR_CRC;
+}
+
+
+// trailer and index are trusted from here on : checked against their crc-32c, and against each other.
+static int _clbrzcrcx8_blockstore_load_metadata(CLBRZCRCx8_BlockStoreReader_t* reader_ptr, uint64_t file_size)
+{
+	uint8_t trailer[CLBRZCRCX8_BLOCKSTORE_TRAILER_SIZE];
+	uint8_t* index;
+	size_t entry_size;
+	uint64_t index_size;
+	uint64_t block_index;
+	uint32_t file_crc;
+	int result;
+
+	if(file_size < CLBRZCRCX8_BLOCKSTORE_TRAILER_SIZE)
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT;
+	}
+	result = _clbrzcrcx8_blockstore_pread(reader_ptr->file_descriptor, trailer, sizeof(trailer), file_size - sizeof(trailer));
+	if(result != CLBRZCRCX8_BLOCKSTORE_OK)
+	{
+		return result;
+	}
+
+	if( (memcmp(&trailer[TRAILER_MAGIC], blockstore_magic, sizeof(blockstore_magic)) != 0) ||
+		(_clbrzcrcx8_get_le(&trailer[TRAILER_TRAILER_CRC], 4) !=
+			clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, trailer, TRAILER_TRAILER_CRC)) )
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT;
+	}
+	// an intact trailer can still hold flags no writer puts there.
+	if((trailer[TRAILER_REFLECT_INPUT] > 1) || (trailer[TRAILER_REFLECT_OUTPUT] > 1))
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT;
+	}
+
+	reader_ptr->crc_configuration.name = "blockstore";
+	reader_ptr->crc_configuration.width = trailer[TRAILER_WIDTH];
+	reader_ptr->crc_configuration.reflect_input = trailer[TRAILER_REFLECT_INPUT];
+	reader_ptr->crc_configuration.reflect_output = trailer[TRAILER_REFLECT_OUTPUT];
+	reader_ptr->crc_configuration.polynomial = (uint32_t)_clbrzcrcx8_get_le(&trailer[TRAILER_POLYNOMIAL], 4);
+	reader_ptr->crc_configuration.initial_value = (uint32_t)_clbrzcrcx8_get_le(&trailer[TRAILER_INITIAL_VALUE], 4);
+	reader_ptr->crc_configuration.final_xor_value = (uint32_t)_clbrzcrcx8_get_le(&trailer[TRAILER_FINAL_XOR_VALUE], 4);
+	reader_ptr->block_size = (uint32_t)_clbrzcrcx8_get_le(&trailer[TRAILER_BLOCK_SIZE], 4);
+	reader_ptr->data_length = _clbrzcrcx8_get_le(&trailer[TRAILER_DATA_LENGTH], 8);
+	reader_ptr->block_count = _clbrzcrcx8_get_le(&trailer[TRAILER_BLOCK_COUNT], 8);
+	reader_ptr->file_crc = (uint32_t)_clbrzcrcx8_get_le(&trailer[TRAILER_FILE_CRC], 4);
+
+	// the sizes must add up to the file size exactly, checked without overflow.
+	if( (reader_ptr->crc_configuration.width < 8) || (reader_ptr->crc_configuration.width > 32) || (reader_ptr->block_size == 0) ||
+		(reader_ptr->block_count != (reader_ptr->data_length / reader_ptr->block_size) + ((reader_ptr->data_length % reader_ptr->block_size) != 0)) )
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT;
+	}
+	entry_size = INDEX_ENTRY_SIZE(reader_ptr->crc_configuration.width);
+	if( (reader_ptr->block_count > (file_size - sizeof(trailer)) / entry_size) ||
+		(reader_ptr->data_length != file_size - sizeof(trailer) - reader_ptr->block_count * entry_size) ||
+		(reader_ptr->block_count > SIZE_MAX / sizeof(uint32_t)) )
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT;
+	}
+	index_size = reader_ptr->block_count * entry_size;
+
+	index = (uint8_t*)malloc((size_t)index_size + 1);
+	reader_ptr->block_crcs = (uint32_t*)malloc((size_t)reader_ptr->block_count * sizeof(uint32_t) + 1);
+	if((index == NULL) || (reader_ptr->block_crcs == NULL))
+	{
+		free(index);
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_MEMORY;
+	}
+	result = _clbrzcrcx8_blockstore_pread(reader_ptr->file_descriptor, index, (size_t)index_size, reader_ptr->data_length);
+	if( (result == CLBRZCRCX8_BLOCKSTORE_OK) &&
+		(_clbrzcrcx8_get_le(&trailer[TRAILER_INDEX_CRC], 4) !=
+			clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, index, (size_t)index_size)) )
+	{
+		result = CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT;
+	}
+
+	// decode, and the index must combine to the file crc.
+	file_crc = clbrzcrcx8_calculate_crc(&reader_ptr->crc_configuration, index, 0);
+	for (block_index = 0; (result == CLBRZCRCX8_BLOCKSTORE_OK) && (block_index < reader_ptr->block_count); block_index++)
+	{
+		reader_ptr->block_crcs[block_index] = (uint32_t)_clbrzcrcx8_get_le(&index[block_index * entry_size], (int)entry_size);
+		file_crc = (block_index == 0) ? reader_ptr->block_crcs[0] :
+					clbrzcrcx8_combine_crc(&reader_ptr->crc_configuration, file_crc, reader_ptr->block_crcs[block_index],
+											_clbrzcrcx8_blockstore_block_length(reader_ptr, block_index));
+	}
+	if((result == CLBRZCRCX8_BLOCKSTORE_OK) && (file_crc != reader_ptr->file_crc))
+	{
+		result = CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT;
+	}
+
+	free(index);
+	return result;
+}
+
+
+int clbrzcrcx8_blockstore_open_reader(CLBRZCRCx8_BlockStoreReader_t* reader_ptr, const char* file_path)
+{
+	struct stat file_status;
+	int result;
+
+	if((reader_ptr == NULL) || (file_path == NULL))
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_ARGUMENT;
+	}
+	memset(reader_ptr, 0, sizeof(*reader_ptr));
+
+	reader_ptr->file_descriptor = open(file_path, O_RDONLY);
+	if(reader_ptr->file_descriptor < 0)
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_IO;
+	}
+
+	if(fstat(reader_ptr->file_descriptor, &file_status) != 0)
+	{
+		result = CLBRZCRCX8_BLOCKSTORE_ERROR_IO;
+	}
+	else
+	{
+		result = _clbrzcrcx8_blockstore_load_metadata(reader_ptr, (uint64_t)file_status.st_size);
+	}
+	if(result == CLBRZCRCX8_BLOCKSTORE_OK)
+	{
+		reader_ptr->block_buffer = (uint8_t*)malloc(reader_ptr->block_size);
+		if(reader_ptr->block_buffer == NULL)
+		{
+			result = CLBRZCRCX8_BLOCKSTORE_ERROR_MEMORY;
+		}
+	}
+
+	if(result != CLBRZCRCX8_BLOCKSTORE_OK)
+	{
+		clbrzcrcx8_blockstore_close_reader(reader_ptr);
+	}
+	return result;
+}
+
+
+int clbrzcrcx8_blockstore_read(CLBRZCRCx8_BlockStoreReader_t* reader_ptr, uint64_t offset, void* data, size_t data_len)
+{
+	uint8_t* byte_data = (uint8_t*)data;
+	uint64_t block_index;
+	uint32_t block_offset;
+	uint32_t block_len;
+	size_t copy_len;
+	int result;
+
+	if((offset > reader_ptr->data_length) || (data_len > reader_ptr->data_length - offset))
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_ARGUMENT;
+	}
+
+	while(data_len > 0)
+	{
+		block_index = offset / reader_ptr->block_size;
+		block_offset = (uint32_t)(offset % reader_ptr->block_size);
+		block_len = _clbrzcrcx8_blockstore_block_length(reader_ptr, block_index);
+		copy_len = block_len - block_offset;
+		if(copy_len > data_len)
+		{
+			copy_len = data_len;
+		}
+
+		if(copy_len == block_len)
+		{
+			// whole block : read and check it in the caller's buffer (which holds the bad data on a crc error).
+			result = _clbrzcrcx8_blockstore_pread(reader_ptr->file_descriptor, byte_data, block_len, block_index * reader_ptr->block_size);
+			if(result == CLBRZCRCX8_BLOCKSTORE_OK)
+			{
+				result = _clbrzcrcx8_blockstore_check_block(reader_ptr, block_index, byte_data);
+			}
+		}
+		else
+		{
+			result = _clbrzcrcx8_blockstore_pread(reader_ptr->file_descriptor, reader_ptr->block_buffer, block_len, block_index * reader_ptr->block_size);
+			if(result == CLBRZCRCX8_BLOCKSTORE_OK)
+			{
+				result = _clbrzcrcx8_blockstore_check_block(reader_ptr, block_index, reader_ptr->block_buffer);
+			}
+			if(result == CLBRZCRCX8_BLOCKSTORE_OK)
+			{
+				memcpy(byte_data, &reader_ptr->block_buffer[block_offset], copy_len);
+			}
+		}
+		if(result != CLBRZCRCX8_BLOCKSTORE_OK)
+		{
+			return result;
+		}
+
+		byte_data += copy_len;
+		offset += copy_len;
+		data_len -= copy_len;
+	}
+
+	return CLBRZCRCX8_BLOCKSTORE_OK;
+}
+
+
+// VERIFY : the blocks are split in thread_count contiguous ranges, each thread preads and checks its own range.
+struct verify_job
+{
+	const CLBRZCRCx8_BlockStoreReader_t* reader_ptr;
+	uint64_t	first_block;
+	uint64_t	end_block;
+	uint64_t	first_bad_block;
+	int			result;
+};
+
+static void* _clbrzcrcx8_blockstore_verify_range(void* job_ptr)
+{
+	struct verify_job* job = (struct verify_job*)job_ptr;
+	const CLBRZCRCx8_BlockStoreReader_t* reader_ptr = job->reader_ptr;
+	uint8_t* block_buffer = (uint8_t*)malloc(reader_ptr->block_size);
+	uint64_t block_index;
+
+	job->result = (block_buffer == NULL) ? CLBRZCRCX8_BLOCKSTORE_ERROR_MEMORY : CLBRZCRCX8_BLOCKSTORE_OK;
+
+	for (block_index = job->first_block; (job->result == CLBRZCRCX8_BLOCKSTORE_OK) && (block_index < job->end_block); block_index++)
+	{
+		job->result = _clbrzcrcx8_blockstore_pread(reader_ptr->file_descriptor, block_buffer,
+													_clbrzcrcx8_blockstore_block_length(reader_ptr, block_index),
+													block_index * reader_ptr->block_size);
+		if(job->result == CLBRZCRCX8_BLOCKSTORE_OK)
+		{
+			job->result = _clbrzcrcx8_blockstore_check_block(reader_ptr, block_index, block_buffer);
+		}
+		if(job->result == CLBRZCRCX8_BLOCKSTORE_ERROR_CRC)
+		{
+			job->first_bad_block = block_index;
+		}
+	}
+
+	free(block_buffer);
+	return NULL;
+}
+
+
+int clbrzcrcx8_blockstore_verify(CLBRZCRCx8_BlockStoreReader_t* reader_ptr, unsigned int thread_count, uint64_t* first_bad_block)
+{
+	struct verify_job* jobs;
+	pthread_t* threads;
+	unsigned char* thread_started;
+	unsigned int thread_index;
+	int result = CLBRZCRCX8_BLOCKSTORE_OK;
+
+	if(thread_count == 0)
+	{
+		thread_count = 1;
+	}
+	if(thread_count > reader_ptr->block_count)
+	{
+		thread_count = (reader_ptr->block_count == 0) ? 1 : (unsigned int)reader_ptr->block_count;
+	}
+
+	jobs = (struct verify_job*)calloc(thread_count, sizeof(struct verify_job));
+	threads = (pthread_t*)calloc(thread_count, sizeof(pthread_t));
+	thread_started = (unsigned char*)calloc(thread_count, 1);
+	if((jobs == NULL) || (threads == NULL) || (thread_started == NULL))
+	{
+		free(jobs);
+		free(threads);
+		free(thread_started);
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_MEMORY;
+	}
+
+	for (thread_index = 0; thread_index < thread_count; thread_index++)
+	{
+		jobs[thread_index].reader_ptr = reader_ptr;
+		jobs[thread_index].first_block = reader_ptr->block_count * thread_index / thread_count;
+		jobs[thread_index].end_block = reader_ptr->block_count * (thread_index + 1) / thread_count;
+
+		// the last range runs in this thread, and so does any range that could not get a thread of its own.
+		if(thread_index + 1 < thread_count)
+		{
+			thread_started[thread_index] = (pthread_create(&threads[thread_index], NULL, _clbrzcrcx8_blockstore_verify_range, &jobs[thread_index]) == 0);
+		}
+		if(!thread_started[thread_index])
+		{
+			_clbrzcrcx8_blockstore_verify_range(&jobs[thread_index]);
+		}
+	}
+
+	// the lowest bad block wins, ranges are in block order.
+	for (thread_index = 0; thread_index < thread_count; thread_index++)
+	{
+		if(thread_started[thread_index])
+		{
+			pthread_join(threads[thread_index], NULL);
+		}
+		if((result == CLBRZCRCX8_BLOCKSTORE_OK) && (jobs[thread_index].result != CLBRZCRCX8_BLOCKSTORE_OK))
+		{
+			result = jobs[thread_index].result;
+			if((result == CLBRZCRCX8_BLOCKSTORE_ERROR_CRC) && (first_bad_block != NULL))
+			{
+				*first_bad_block = jobs[thread_index].first_bad_block;
+			}
+		}
+	}
+
+	free(jobs);
+	free(threads);
+	free(thread_started);
+	return result;
+}
+
+
+// MAPPED READER
+
+int clbrzcrcx8_blockstore_map(CLBRZCRCx8_BlockStoreReader_t* reader_ptr)
+{
+	size_t file_size = (size_t)(reader_ptr->data_length +
+								reader_ptr->block_count * INDEX_ENTRY_SIZE(reader_ptr->crc_configuration.width) +
+								CLBRZCRCX8_BLOCKSTORE_TRAILER_SIZE);
+	void* mapped_data;
+
+	if(reader_ptr->mapped_data != NULL)
+	{
+		return CLBRZCRCX8_BLOCKSTORE_OK;
+	}
+
+	reader_ptr->block_states = calloc((size_t)reader_ptr->block_count + 1, sizeof(block_state_t));
+	if(reader_ptr->block_states == NULL)
+	{
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_MEMORY;
+	}
+
+	mapped_data = mmap(NULL, file_size, PROT_READ, MAP_SHARED, reader_ptr->file_descriptor, 0);
+	if(mapped_data == MAP_FAILED)
+	{
+		free(reader_ptr->block_states);
+		reader_ptr->block_states = NULL;
+		return CLBRZCRCX8_BLOCKSTORE_ERROR_IO;
+	}
+	reader_ptr->mapped_data = (const uint8_t*)mapped_data;
+	reader_ptr->mapped_length = file_size;
+
+	return CLBRZCRCX8_BLOCKSTORE_OK;
+}
+
+
+const uint8_t* clbrzcrcx8_blockstore_mapped_block(CLBRZCRCx8_BlockStoreReader_t* reader_ptr, uint64_t block_index, uint32_t* block_length)
+{
+	block_state_t* block_state;
+	const uint8_t* block_data;
+	unsigned char state;
+
+	if((reader_ptr->mapped_data == NULL) || (block_index >= reader_ptr->block_count))
+	{
+		return NULL;
+	}
+	block_state = &((block_state_t*)reader_ptr->block_states)[block_index];
+	block_data = reader_ptr->mapped_data + block_index * reader_ptr->block_size;
+
+	// two threads may both check a new block, they store the same answer.
+	state = BLOCK_STATE_LOAD(block_state);
+	if(state == BLOCK_NOT_CHECKED)
+	{
+		state = (_clbrzcrcx8_blockstore_check_block(reader_ptr, block_index, block_data) == CLBRZCRCX8_BLOCKSTORE_OK) ? BLOCK_GOOD : BLOCK_BAD;
+		BLOCK_STATE_STORE(block_state, state);
+	}
+
+	if(state != BLOCK_GOOD)
+	{
+		return NULL;
+	}
+	if(block_length != NULL)
+	{
+		*block_length = _clbrzcrcx8_blockstore_block_length(reader_ptr, block_index);
+	}
+	return block_data;
+}
+
+
+void clbrzcrcx8_blockstore_close_reader(CLBRZCRCx8_BlockStoreReader_t* reader_ptr)
+{
+	if(reader_ptr->mapped_data != NULL)
+	{
+		munmap((void*)reader_ptr->mapped_data, reader_ptr->mapped_length);
+		reader_ptr->mapped_data = NULL;
+	}
+	if(reader_ptr->file_descriptor >= 0)
+	{
+		close(reader_ptr->file_descriptor);
+		reader_ptr->file_descriptor = -1;
+	}
+	free(reader_ptr->block_states);
+	free(reader_ptr->block_crcs);
+	free(reader_ptr->block_buffer);
+	reader_ptr->block_states = NULL;
+	reader_ptr->block_crcs = NULL;
+	reader_ptr->block_buffer = NULL;
+}
+
+
+
+#ifdef CLBRZCRCX8_ENABLE_BLOCKSTORE_TEST
+
+#include <stdio.h>
+
+#define BLOCKSTORE_TEST_DATA_SIZE		(1024 * 1024 + 123)
+#define BLOCKSTORE_TEST_BLOCK_SIZE		4096
+#define BLOCKSTORE_TEST_BAD_BLOCK		37
+#define BLOCKSTORE_TEST_BLOCK_COUNT		((BLOCKSTORE_TEST_DATA_SIZE + BLOCKSTORE_TEST_BLOCK_SIZE - 1) / BLOCKSTORE_TEST_BLOCK_SIZE)
+
+static uint8_t blockstore_test_data[BLOCKSTORE_TEST_DATA_SIZE];
+static uint8_t blockstore_test_read[BLOCKSTORE_TEST_DATA_SIZE];
+
+
+// flip one bit in the file, at file_offset.
+static int _clbrzcrcx8_blockstore_test_corrupt(const char* file_path, uint64_t file_offset)
+{
+	int file_descriptor = open(file_path, O_RDWR);
+	uint8_t byte_value;
+	int result = 0;
+
+	if(file_descriptor < 0)
+	{
+		return 0;
+	}
+	if(pread(file_descriptor, &byte_value, 1, (off_t)file_offset) == 1)
+	{
+		byte_value ^= 0x10;
+		result = (pwrite(file_descriptor, &byte_value, 1, (off_t)file_offset) == 1);
+	}
+	close(file_descriptor);
+	return result;
+}
+
+
+// rewrite one byte of the trailer at trailer_offset, with a matching trailer crc : a well formed but made up trailer.
+static int _clbrzcrcx8_blockstore_test_set_trailer(const char* file_path, uint64_t trailer_offset, int field, uint8_t value)
+{
+	int file_descriptor = open(file_path, O_RDWR);
+	uint8_t trailer[CLBRZCRCX8_BLOCKSTORE_TRAILER_SIZE];
+	int result = 0;
+
+	if(file_descriptor < 0)
+	{
+		return 0;
+	}
+	if(pread(file_descriptor, trailer, sizeof(trailer), (off_t)trailer_offset) == (ssize_t)sizeof(trailer))
+	{
+		trailer[field] = value;
+		_clbrzcrcx8_put_le(&trailer[TRAILER_TRAILER_CRC],
+									clbrzcrcx8_calculate_crc(&_clbrzcrcx8_metadata_crc, trailer, TRAILER_TRAILER_CRC), 4);
+		result = (pwrite(file_descriptor, trailer, sizeof(trailer), (off_t)trailer_offset) == (ssize_t)sizeof(trailer));
+	}
+	close(file_descriptor);
+	return result;
+}
+
+
+// write, read back, verify, map, then break a data block, the index and the trailer : all must be caught.
+static int _clbrzcrcx8_blockstore_test(const char* file_path, CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr)
+{
+	CLBRZCRCx8_BlockStoreWriter_t writer;
+	CLBRZCRCx8_BlockStoreReader_t reader;
+	const uint8_t* block_data;
+	uint32_t block_len;
+	uint64_t bad_block = 0;
+	uint64_t trailer_offset;
+	size_t data_offset;
+	size_t piece_len;
+	int result;
+
+	// odd sized pieces, so blocks fill from the buffer and straight from the caller.
+	if(clbrzcrcx8_blockstore_open_writer(&writer, file_path, crc_configuration_ptr, BLOCKSTORE_TEST_BLOCK_SIZE) != CLBRZCRCX8_BLOCKSTORE_OK)
+	{
+		return 0;
+	}
+	for (data_offset = 0; data_offset < BLOCKSTORE_TEST_DATA_SIZE; data_offset += piece_len)
+	{
+		piece_len = (data_offset / 7) % 20000 + 1;
+		if(piece_len > BLOCKSTORE_TEST_DATA_SIZE - data_offset)
+		{
+			piece_len = BLOCKSTORE_TEST_DATA_SIZE - data_offset;
+		}
+		if(clbrzcrcx8_blockstore_write(&writer, &blockstore_test_data[data_offset], piece_len) != CLBRZCRCX8_BLOCKSTORE_OK)
+		{
+			printf("write failed\n");
+			clbrzcrcx8_blockstore_close_writer(&writer);
+			return 0;
+		}
+	}
+	if(clbrzcrcx8_blockstore_close_writer(&writer) != CLBRZCRCX8_BLOCKSTORE_OK)
+	{
+		return 0;
+	}
+
+	// open_reader() leaves a reader it could not open closed : every failure below can call close_reader().
+	if(clbrzcrcx8_blockstore_open_reader(&reader, file_path) != CLBRZCRCX8_BLOCKSTORE_OK)
+	{
+		printf("open_reader failed\n");
+		return 0;
+	}
+	if(reader.file_crc != clbrzcrcx8_calculate_crc(crc_configuration_ptr, blockstore_test_data, BLOCKSTORE_TEST_DATA_SIZE))
+	{
+		printf("combined file crc does not match the crc of the data\n");
+		clbrzcrcx8_blockstore_close_reader(&reader);
+		return 0;
+	}
+	memset(blockstore_test_read, 0, sizeof(blockstore_test_read));
+	if( (clbrzcrcx8_blockstore_read(&reader, 0, blockstore_test_read, 5000) != CLBRZCRCX8_BLOCKSTORE_OK) ||
+		(clbrzcrcx8_blockstore_read(&reader, 5000, &blockstore_test_read[5000], BLOCKSTORE_TEST_DATA_SIZE - 5000) != CLBRZCRCX8_BLOCKSTORE_OK) ||
+		(memcmp(blockstore_test_read, blockstore_test_data, BLOCKSTORE_TEST_DATA_SIZE) != 0) ||
+		(clbrzcrcx8_blockstore_read(&reader, BLOCKSTORE_TEST_DATA_SIZE - 10, blockstore_test_read, 11) != CLBRZCRCX8_BLOCKSTORE_ERROR_ARGUMENT) ||
+		(clbrzcrcx8_blockstore_verify(&reader, 4, NULL) != CLBRZCRCX8_BLOCKSTORE_OK) ||
+		(clbrzcrcx8_blockstore_map(&reader) != CLBRZCRCX8_BLOCKSTORE_OK) ||
+		((block_data = clbrzcrcx8_blockstore_mapped_block(&reader, reader.block_count - 1, &block_len)) == NULL) ||
+		(block_len != BLOCKSTORE_TEST_DATA_SIZE % BLOCKSTORE_TEST_BLOCK_SIZE) ||
+		(memcmp(block_data, &blockstore_test_data[(reader.block_count - 1) * BLOCKSTORE_TEST_BLOCK_SIZE], block_len) != 0) )
+	{
+		printf("clean file : read/verify/map failed\n");
+		clbrzcrcx8_blockstore_close_reader(&reader);
+		return 0;
+	}
+	clbrzcrcx8_blockstore_close_reader(&reader);
+
+	// a bad data block : only reads that touch it fail, verify names it, the mapped reader refuses it.
+	_clbrzcrcx8_blockstore_test_corrupt(file_path, BLOCKSTORE_TEST_BAD_BLOCK * BLOCKSTORE_TEST_BLOCK_SIZE + 100);
+	if( (clbrzcrcx8_blockstore_open_reader(&reader, file_path) != CLBRZCRCX8_BLOCKSTORE_OK) ||
+		(clbrzcrcx8_blockstore_read(&reader, 0, blockstore_test_read, BLOCKSTORE_TEST_BAD_BLOCK * BLOCKSTORE_TEST_BLOCK_SIZE) != CLBRZCRCX8_BLOCKSTORE_OK) ||
+		(clbrzcrcx8_blockstore_read(&reader, (BLOCKSTORE_TEST_BAD_BLOCK + 1) * BLOCKSTORE_TEST_BLOCK_SIZE - 1, blockstore_test_read, 2) != CLBRZCRCX8_BLOCKSTORE_ERROR_CRC) ||
+		(clbrzcrcx8_blockstore_verify(&reader, 4, &bad_block) != CLBRZCRCX8_BLOCKSTORE_ERROR_CRC) || (bad_block != BLOCKSTORE_TEST_BAD_BLOCK) ||
+		(clbrzcrcx8_blockstore_verify(&reader, 1, &bad_block) != CLBRZCRCX8_BLOCKSTORE_ERROR_CRC) || (bad_block != BLOCKSTORE_TEST_BAD_BLOCK) ||
+		(clbrzcrcx8_blockstore_map(&reader) != CLBRZCRCX8_BLOCKSTORE_OK) ||
+		(clbrzcrcx8_blockstore_mapped_block(&reader, BLOCKSTORE_TEST_BAD_BLOCK, NULL) != NULL) ||
+		(clbrzcrcx8_blockstore_mapped_block(&reader, BLOCKSTORE_TEST_BAD_BLOCK + 1, NULL) == NULL) )
+	{
+		printf("bad block not caught\n");
+		clbrzcrcx8_blockstore_close_reader(&reader);
+		return 0;
+	}
+	clbrzcrcx8_blockstore_close_reader(&reader);
+	_clbrzcrcx8_blockstore_test_corrupt(file_path, BLOCKSTORE_TEST_BAD_BLOCK * BLOCKSTORE_TEST_BLOCK_SIZE + 100);
+
+	// a bad index entry, then a bad trailer : the file does not open.
+	_clbrzcrcx8_blockstore_test_corrupt(file_path, BLOCKSTORE_TEST_DATA_SIZE + 3);
+	result = clbrzcrcx8_blockstore_open_reader(&reader, file_path);
+	_clbrzcrcx8_blockstore_test_corrupt(file_path, BLOCKSTORE_TEST_DATA_SIZE + 3);
+	if(result != CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT)
+	{
+		printf("bad index not caught\n");
+		clbrzcrcx8_blockstore_close_reader(&reader);
+		return 0;
+	}
+
+	// a trailer with a valid crc but refin = 2 : the file does not open.
+	trailer_offset = BLOCKSTORE_TEST_DATA_SIZE + BLOCKSTORE_TEST_BLOCK_COUNT * INDEX_ENTRY_SIZE(crc_configuration_ptr->width);
+	_clbrzcrcx8_blockstore_test_set_trailer(file_path, trailer_offset, TRAILER_REFLECT_INPUT, 2);
+	result = clbrzcrcx8_blockstore_open_reader(&reader, file_path);
+	_clbrzcrcx8_blockstore_test_set_trailer(file_path, trailer_offset, TRAILER_REFLECT_INPUT, crc_configuration_ptr->reflect_input);
+	if(result != CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT)
+	{
+		printf("bad refin not caught\n");
+		clbrzcrcx8_blockstore_close_reader(&reader);
+		return 0;
+	}
+	_clbrzcrcx8_blockstore_test_corrupt(file_path, trailer_offset + TRAILER_DATA_LENGTH);
+	if(clbrzcrcx8_blockstore_open_reader(&reader, file_path) != CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT)
+	{
+		printf("bad trailer not caught\n");
+		clbrzcrcx8_blockstore_close_reader(&reader);
+		return 0;
+	}
+
+	return 1; // ok.
+}
+
+
+// usage : clbrz_crcx8_blockstore_test [scratch file path]
+int main(int argc, char* argv[])
+{
+	const char* file_path = (argc > 1) ? argv[1] : "clbrz_crcx8_blockstore_test.bin";
+	size_t data_index;
+	int algo_index;
+	int failed = 0;
+
+	srand(0xb10c);
+	for (data_index = 0; data_index < BLOCKSTORE_TEST_DATA_SIZE; data_index++)
+	{
+		blockstore_test_data[data_index] = (uint8_t)rand();
+	}
+
+	// every width, so every index entry size.
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		if(_clbrzcrcx8_blockstore_test(file_path, &clbrzcrcx8_crc_algo_list[algo_index]) == 1)
+		{
+			printf("%-16s : PASS\n", clbrzcrcx8_crc_algo_list[algo_index].name);
+		}
+		else
+		{
+			printf("%-16s : FAIL\n", clbrzcrcx8_crc_algo_list[algo_index].name);
+			failed++;
+		}
+	}
+	remove(file_path);
+
+	return (failed == 0) ? 0 : 1;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_BLOCKSTORE_TEST
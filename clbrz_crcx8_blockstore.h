@@ -0,0 +1,161 @@
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+    This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+
+
+	Description : block store, a block framed file format on top of clbrz_crcx8.
+				 the data is cut in fixed size blocks, each block gets a CRC (any clbrz_crcx8 descriptor),
+				 the block CRCs are kept in a compact index after the data, and a trailer closes the file :
+
+				 [block 0][block 1] ... [block N-1, may be short][index : N CRCs][trailer]
+
+				 index : one entry per block, (width + 7) / 8 bytes, little endian.
+				 trailer (CLBRZCRCX8_BLOCKSTORE_TRAILER_SIZE bytes, little endian) :
+					 magic "CLBRZBS1", block size u32, width/refin/refout/reserved u8, poly/init/xorout u32,
+					 data length u64, block count u64, file CRC u32, index CRC u32, trailer CRC u32.
+				 the file CRC is the CRC of all the data, combined from the block CRCs (no second pass over the data).
+				 the index CRC and the trailer CRC are always CRC-32C, so the trailer can be trusted before its descriptor is.
+
+				 reads verify only the blocks they touch, verify() checks every block in parallel,
+				 the mapped reader checks each block the first time it is asked for.
+				 needs POSIX (pread, mmap, pthreads), link with -pthread.
+
+	usage :
+	(1) writer : open_writer() with a descriptor and block size, write() as many times as needed, close_writer().
+	(2) reader : open_reader(), then read() / verify() / map() + mapped_block(), close_reader().
+
+ ============================================================================
+ */
+
+#ifndef CLBRZ_CRCX8_BLOCKSTORE_H_
+#define CLBRZ_CRCX8_BLOCKSTORE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "clbrz_crcx8.h"
+
+
+//#define CLBRZCRCX8_ENABLE_BLOCKSTORE_TEST		// enable to build the block store test main()
+
+
+#define CLBRZCRCX8_BLOCKSTORE_TRAILER_SIZE		56
+
+// return values : 0 is ok, everything else is an error.
+#define CLBRZCRCX8_BLOCKSTORE_OK				0
+#define CLBRZCRCX8_BLOCKSTORE_ERROR_ARGUMENT	(-1)	// bad parameter, or offset/length outside of the data
+#define CLBRZCRCX8_BLOCKSTORE_ERROR_IO			(-2)	// open/read/write/mmap failed, see errno
+#define CLBRZCRCX8_BLOCKSTORE_ERROR_MEMORY		(-3)
+#define CLBRZCRCX8_BLOCKSTORE_ERROR_FORMAT		(-4)	// not a block store file, or trailer/index damaged
+#define CLBRZCRCX8_BLOCKSTORE_ERROR_CRC			(-5)	// a data block does not match its CRC
+
+
+typedef struct _crcBlockStoreWriter
+{
+	FILE*		file;
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+	uint32_t	block_size;
+	uint32_t	block_fill;			// bytes in block_buffer
+	uint8_t*	block_buffer;
+	uint8_t*	index;				// index entries so far, as they go to the file
+	uint64_t	index_capacity;		// in blocks
+	uint64_t	block_count;
+	uint64_t	data_length;
+	uint32_t	file_crc;
+
+} CLBRZCRCx8_BlockStoreWriter_t;
+
+
+typedef struct _crcBlockStoreReader
+{
+	int			file_descriptor;
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+	uint32_t	block_size;
+	uint64_t	block_count;
+	uint64_t	data_length;
+	uint32_t	file_crc;
+	uint32_t*	block_crcs;			// the index, decoded
+	uint8_t*	block_buffer;		// scratch for partial block reads
+	const uint8_t* mapped_data;		// map() : the whole file, NULL before
+	size_t		mapped_length;
+	void*		block_states;		// map() : per block, not checked yet / good / bad
+
+} CLBRZCRCx8_BlockStoreReader_t;
+
+
+// create (truncate) the file, crc_configuration_ptr is copied.
+int clbrzcrcx8_blockstore_open_writer(CLBRZCRCx8_BlockStoreWriter_t* writer_ptr,
+										const char* file_path,
+										const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+										uint32_t block_size);
+
+// append data, full blocks go to the file as they fill up.
+int clbrzcrcx8_blockstore_write(CLBRZCRCx8_BlockStoreWriter_t* writer_ptr, const void* data, size_t data_len);
+
+// write the last (short) block, the index and the trailer, close the file. the writer is freed even on error.
+int clbrzcrcx8_blockstore_close_writer(CLBRZCRCx8_BlockStoreWriter_t* writer_ptr);
+
+
+// open the file, check the trailer and the index (not the data). the descriptor is rebuilt from the trailer.
+int clbrzcrcx8_blockstore_open_reader(CLBRZCRCx8_BlockStoreReader_t* reader_ptr, const char* file_path);
+
+// read data_len bytes from data offset, every block touched is checked against its CRC first. one thread per reader.
+int clbrzcrcx8_blockstore_read(CLBRZCRCx8_BlockStoreReader_t* reader_ptr, uint64_t offset, void* data, size_t data_len);
+
+// check every block, on thread_count threads (0 or 1 : in the calling thread).
+// on CRC error, *first_bad_block (if not NULL) is the lowest bad block index.
+int clbrzcrcx8_blockstore_verify(CLBRZCRCx8_BlockStoreReader_t* reader_ptr, unsigned int thread_count, uint64_t* first_bad_block);
+
+// map the file, blocks are then checked lazily by mapped_block().
+int clbrzcrcx8_blockstore_map(CLBRZCRCx8_BlockStoreReader_t* reader_ptr);
+
+// the mapped block, checked on first access (any thread), NULL if it is bad or out of range.
+const uint8_t* clbrzcrcx8_blockstore_mapped_block(CLBRZCRCx8_BlockStoreReader_t* reader_ptr, uint64_t block_index, uint32_t* block_length);
+
+void clbrzcrcx8_blockstore_close_reader(CLBRZCRCx8_BlockStoreReader_t* reader_ptr);
+
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif /* CLBRZ_CRCX8_BLOCKSTORE_H_ */
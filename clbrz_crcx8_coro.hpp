@@ -0,0 +1,257 @@
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+    This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+
+
+	Description : C++20 wrapper around the clbrz_crcx8 crc state (CLBRZCRCx8_CRCState_t), and a coroutine that runs
+				 a large update in byte_budget sized steps, so an event loop can do other work in between.
+				 the stream is a plain value : it can be copied, suspended, and moved to another thread,
+				 and state() can be stored as it is and picked up again with crc_stream(state).
+
+	usage :
+		// name, width, poly, init, xorout, refin, refout, check : a descriptor of your own, or one of clbrzcrcx8_crc_algo_list[] found by .name.
+		static const CLBRZCRCx8_CRCTypeDescriptor_t crc32 = { "CRC-32", 32, 0x04c11db7, 0xffffffff, 0xffffffff, 1, 1, 0xcbf43926, 0 };
+		clbrzcrcx8::crc_stream crc(crc32);
+		clbrzcrcx8::crc_stream::job job = crc.update_in_steps(body, body_len, 64 * 1024);
+		while(job.step())
+		{
+			// other work here, or co_await the event loop's own yield/post.
+		}
+		uint32_t body_crc = crc.finalize();
+
+ ============================================================================
+ */
+
+#ifndef CLBRZ_CRCX8_CORO_HPP_
+#define CLBRZ_CRCX8_CORO_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+#include "clbrz_crcx8.h"
+
+
+//#define CLBRZCRCX8_ENABLE_CORO_TEST				// enable to build the coroutine wrapper test main(), compile this file as c++
+
+
+namespace clbrzcrcx8
+{
+
+class crc_stream
+{
+public:
+	explicit crc_stream(const CLBRZCRCx8_CRCTypeDescriptor_t& crc_configuration)
+	{
+		clbrzcrcx8_init_crc_state(&crc_state_, &crc_configuration);
+	}
+
+	// resume a stream from a stored/moved state.
+	explicit crc_stream(const CLBRZCRCx8_CRCState_t& crc_state) : crc_state_(crc_state) {}
+
+	uint32_t update(const void* data, std::size_t data_len)	{ return clbrzcrcx8_update_crc_state(&crc_state_, data, data_len); }
+	uint32_t finalize() const								{ return clbrzcrcx8_finalize_crc_state(&crc_state_); }
+	void reset()											{ clbrzcrcx8_reset_crc_state(&crc_state_); }
+	uint64_t byte_count() const								{ return crc_state_.byte_count; }
+	const CLBRZCRCx8_CRCState_t& state() const				{ return crc_state_; }
+
+	class job;
+
+	// the data, and this stream, must stay alive until the job is done (or destroyed).
+	// byte_budget 0 : all of it in one step.
+	job update_in_steps(const void* data, std::size_t data_len, std::size_t byte_budget);
+
+private:
+	CLBRZCRCx8_CRCState_t crc_state_;
+};
+
+
+// a lazily started coroutine : nothing runs until step(), each step() does one byte budget of the update
+// and returns true while there is more to do. it can be stepped from any thread, one at a time.
+class crc_stream::job
+{
+public:
+	struct promise_type
+	{
+		job get_return_object()							{ return job(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend() noexcept	{ return {}; }
+		std::suspend_always final_suspend() noexcept	{ return {}; }
+		std::suspend_always yield_value(std::size_t) noexcept	{ return {}; }
+		void return_void() noexcept						{}
+		void unhandled_exception()						{ std::terminate(); }
+	};
+
+	job(job&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+	job& operator=(job&& other) noexcept
+	{
+		if(this != &other)
+		{
+			destroy();
+			handle_ = std::exchange(other.handle_, nullptr);
+		}
+		return *this;
+	}
+
+	job(const job&) = delete;
+	job& operator=(const job&) = delete;
+
+	~job() { destroy(); }
+
+	bool step()
+	{
+		if(done())
+		{
+			return false;
+		}
+		handle_.resume();
+		return !handle_.done();
+	}
+
+	bool done() const { return !handle_ || handle_.done(); }
+
+private:
+	explicit job(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+	void destroy()
+	{
+		if(handle_)
+		{
+			handle_.destroy();
+			handle_ = nullptr;
+		}
+	}
+
+	std::coroutine_handle<promise_type> handle_;
+};
+
+
+inline crc_stream::job crc_stream::update_in_steps(const void* data, std::size_t data_len, std::size_t byte_budget)
+{
+	const uint8_t* byte_data = static_cast<const uint8_t*>(data);
+	std::size_t step_len;
+
+	while(data_len > 0)
+	{
+		step_len = ((byte_budget == 0) || (data_len < byte_budget)) ? data_len : byte_budget;
+		update(byte_data, step_len);
+		byte_data += step_len;
+		data_len -= step_len;
+
+		if(data_len > 0)
+		{
+			co_yield step_len;
+		}
+	}
+}
+
+} // namespace clbrzcrcx8
+
+
+#ifdef CLBRZCRCX8_ENABLE_CORO_TEST
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// two bodies interleaved step by step on one "event loop", one of them moved to another thread half way,
+// and a stream stored as bytes and resumed : all must match the one shot crc.
+int main()
+{
+	std::vector<uint8_t> body_a(1000003);
+	std::vector<uint8_t> body_b(77777);
+	int failed = 0;
+
+	for (std::size_t byte_index = 0; byte_index < body_a.size(); byte_index++)
+	{
+		body_a[byte_index] = (uint8_t)(byte_index * 131 + 7);
+	}
+	for (std::size_t byte_index = 0; byte_index < body_b.size(); byte_index++)
+	{
+		body_b[byte_index] = (uint8_t)(byte_index * 17 + 3);
+	}
+
+	for (int algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		const CLBRZCRCx8_CRCTypeDescriptor_t& crc_configuration = clbrzcrcx8_crc_algo_list[algo_index];
+		clbrzcrcx8::crc_stream crc_a(crc_configuration);
+		clbrzcrcx8::crc_stream crc_b(crc_configuration);
+		clbrzcrcx8::crc_stream::job job_a = crc_a.update_in_steps(body_a.data(), body_a.size(), 64 * 1024);
+		clbrzcrcx8::crc_stream::job job_b = crc_b.update_in_steps(body_b.data(), body_b.size(), 4096);
+		int steps_a = 0;
+
+		while(!job_a.done() || !job_b.done())
+		{
+			job_a.step();
+			job_b.step();
+			if(++steps_a == 8)
+			{
+				std::thread([&job_a]() { job_a.step(); }).join();
+			}
+		}
+
+		// suspend : the state as bytes, resume in a new stream.
+		clbrzcrcx8::crc_stream crc_c(crc_configuration);
+		CLBRZCRCx8_CRCState_t stored_state;
+		crc_c.update(body_b.data(), 1000);
+		std::memcpy(&stored_state, &crc_c.state(), sizeof(stored_state));
+		clbrzcrcx8::crc_stream crc_d(stored_state);
+		crc_d.update(body_b.data() + 1000, body_b.size() - 1000);
+
+		if( (crc_a.finalize() != clbrzcrcx8_calculate_crc(&crc_configuration, body_a.data(), body_a.size())) ||
+			(crc_b.finalize() != clbrzcrcx8_calculate_crc(&crc_configuration, body_b.data(), body_b.size())) ||
+			(crc_d.finalize() != crc_b.finalize()) ||
+			(crc_a.byte_count() != body_a.size()) || (crc_d.byte_count() != body_b.size()) )
+		{
+			std::printf("%-16s : FAIL\n", crc_configuration.name);
+			failed++;
+		}
+		else
+		{
+			std::printf("%-16s : PASS\n", crc_configuration.name);
+		}
+	}
+
+	return (failed == 0) ? 0 : 1;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_CORO_TEST
+
+#endif /* CLBRZ_CRCX8_CORO_HPP_ */
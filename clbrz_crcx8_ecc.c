@@ -0,0 +1,542 @@
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+    This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+
+
+	Description : error correction from CRC syndromes, see clbrz_crcx8_ecc.h
+
+ ============================================================================
+ */
+
+#include "clbrz_crcx8_ecc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+#define ECC_CRC_MASK(width)			((((1UL << ((width) - 1UL)) - 1UL) << 1UL) | 1UL)
+#define ECC_TOPBIT(width)			(1UL << ((width) - 1UL))
+
+#define ECC_NO_DISTANCE				0xffff		// second distance of a single bit pattern, limit of a unique syndrome
+#define ECC_HASH(syndrome, bits)	((uint32_t)((syndrome) * 0x9e3779b1UL) >> (32 - (bits)))
+#define ECC_BATCH_SIZE				64
+
+
+// one error pattern. bit distances count from the last bit of the frame (0) backwards, in the order the CRC reads the bits.
+typedef struct _eccSlot
+{
+	uint32_t	syndrome;		// 0 : empty, no correctable pattern has syndrome 0
+	uint16_t	distance[2];	// the farther bit first, [1] = ECC_NO_DISTANCE for a single bit
+	uint16_t	limit;			// frames longer than limit bits could also hold another pattern with this syndrome
+
+} ecc_slot;
+
+
+// syndrome of a single bit at distance from the frame end : x^(distance + width) mod P, as the finalized CRC shows it.
+static void _clbrzcrcx8_ecc_bit_syndromes(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, uint32_t* bit_syndromes, size_t bit_count)
+{
+	uint32_t polynomial = crc_configuration_ptr->polynomial & ECC_CRC_MASK(crc_configuration_ptr->width);
+	uint32_t crc_register = polynomial;		// x^width mod P
+	size_t distance;
+
+	for (distance = 0; distance < bit_count; distance++)
+	{
+		bit_syndromes[distance] = (crc_configuration_ptr->reflect_output) ?
+									(clbrzcrcx8_reflect(crc_register, crc_configuration_ptr->width) & ECC_CRC_MASK(crc_configuration_ptr->width)) :
+									crc_register;
+		crc_register = ((crc_register & ECC_TOPBIT(crc_configuration_ptr->width)) != 0) ? ((crc_register << 1) ^ polynomial) : (crc_register << 1);
+		crc_register &= ECC_CRC_MASK(crc_configuration_ptr->width);
+	}
+}
+
+
+// patterns must come in order of their farther distance : a syndrome seen before belongs to a pattern that fits in shorter frames.
+static void _clbrzcrcx8_ecc_insert(CLBRZCRCx8_EccCorrector_t* corrector_ptr, uint32_t syndrome, uint16_t distance_0, uint16_t distance_1)
+{
+	ecc_slot* slots = (ecc_slot*)corrector_ptr->slots;
+	uint32_t slot_mask = (1UL << corrector_ptr->slot_bits) - 1;
+	uint32_t slot_index = ECC_HASH(syndrome, corrector_ptr->slot_bits);
+
+	// 0 : the pattern is a multiple of the polynomial (frame longer than its period), it can not even be detected.
+	if(syndrome == 0)
+	{
+		return;
+	}
+
+	while(slots[slot_index].syndrome != 0)
+	{
+		if(slots[slot_index].syndrome == syndrome)
+		{
+			if(distance_0 < slots[slot_index].limit)
+			{
+				slots[slot_index].limit = distance_0;
+			}
+			return;
+		}
+		slot_index = (slot_index + 1) & slot_mask;
+	}
+
+	slots[slot_index].syndrome = syndrome;
+	slots[slot_index].distance[0] = distance_0;
+	slots[slot_index].distance[1] = distance_1;
+	slots[slot_index].limit = ECC_NO_DISTANCE;
+	corrector_ptr->pattern_count++;
+}
+
+
+static const ecc_slot* _clbrzcrcx8_ecc_lookup(const CLBRZCRCx8_EccCorrector_t* corrector_ptr, uint32_t syndrome)
+{
+	const ecc_slot* slots = (const ecc_slot*)corrector_ptr->slots;
+	uint32_t slot_mask = (1UL << corrector_ptr->slot_bits) - 1;
+	uint32_t slot_index = ECC_HASH(syndrome, corrector_ptr->slot_bits);
+
+	while(slots[slot_index].syndrome != 0)
+	{
+		if(slots[slot_index].syndrome == syndrome)
+		{
+			return &slots[slot_index];
+		}
+		slot_index = (slot_index + 1) & slot_mask;
+	}
+
+	return NULL;
+}
+
+
+// frame byte and bit of a bit distance, the inverse of the CRC's bit order (LSB first when reflected).
+static size_t _clbrzcrcx8_ecc_bit_position(const CLBRZCRCx8_EccCorrector_t* corrector_ptr, size_t frame_len, uint16_t distance)
+{
+	size_t byte_index = frame_len - 1 - distance / 8;
+	uint8_t bit_index = (uint8_t)(distance % 8);
+
+	return byte_index * 8 + (corrector_ptr->crc_configuration.reflect_input ? (7 - bit_index) : bit_index);
+}
+
+
+static int _clbrzcrcx8_ecc_repair(const CLBRZCRCx8_EccCorrector_t* corrector_ptr, uint8_t* frame, size_t frame_len,
+									uint32_t syndrome, size_t* bit_positions)
+{
+	const ecc_slot* slot;
+	size_t frame_bits = frame_len * 8;
+	size_t bit_position;
+	int bit_count;
+
+	if(syndrome == 0)
+	{
+		return 0;
+	}
+
+	slot = _clbrzcrcx8_ecc_lookup(corrector_ptr, syndrome);
+	if( (slot == NULL) || (slot->distance[0] >= frame_bits) || (frame_bits > slot->limit) )
+	{
+		return CLBRZCRCX8_ECC_ERROR_UNCORRECTABLE;
+	}
+
+	for (bit_count = 0; (bit_count < 2) && (slot->distance[bit_count] != ECC_NO_DISTANCE); bit_count++)
+	{
+		bit_position = _clbrzcrcx8_ecc_bit_position(corrector_ptr, frame_len, slot->distance[bit_count]);
+		frame[bit_position / 8] ^= (uint8_t)(1U << (bit_position % 8));
+		if(bit_positions != NULL)
+		{
+			bit_positions[bit_count] = bit_position;
+		}
+	}
+
+	// the farther bit comes first in the frame, unless both are in one byte and the CRC reads it MSB first.
+	if( (bit_positions != NULL) && (bit_count == 2) && (bit_positions[1] < bit_positions[0]) )
+	{
+		bit_position = bit_positions[0];
+		bit_positions[0] = bit_positions[1];
+		bit_positions[1] = bit_position;
+	}
+
+	return bit_count;
+}
+
+
+int clbrzcrcx8_ecc_init(CLBRZCRCx8_EccCorrector_t* corrector_ptr,
+						const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+						uint32_t max_frame_len,
+						uint8_t max_errors)
+{
+	uint8_t empty_frame[4] = { 0 };
+	uint32_t* bit_syndromes;
+	size_t bit_count;
+	size_t pattern_estimate;
+	size_t distance_0;
+	size_t distance_1;
+
+	if( (corrector_ptr == NULL) || (crc_configuration_ptr == NULL) ||
+		(crc_configuration_ptr->width < 8) || (crc_configuration_ptr->width > 32) || ((crc_configuration_ptr->width % 8) != 0) ||
+		(crc_configuration_ptr->reflect_input != crc_configuration_ptr->reflect_output) ||
+		(max_frame_len <= (uint32_t)crc_configuration_ptr->width / 8) || (max_frame_len > CLBRZCRCX8_ECC_MAX_FRAME_LEN) ||
+		(max_errors < 1) || (max_errors > 2) )
+	{
+		return CLBRZCRCX8_ECC_ERROR_ARGUMENT;
+	}
+
+	memset(corrector_ptr, 0, sizeof(*corrector_ptr));
+	corrector_ptr->crc_configuration = *crc_configuration_ptr;
+	corrector_ptr->crc_bytes = crc_configuration_ptr->width / 8;
+	corrector_ptr->max_frame_len = max_frame_len;
+	corrector_ptr->max_errors = max_errors;
+
+	// the residue, from the shortest frame there is : no data, only its CRC.
+	clbrzcrcx8_ecc_append_crc(corrector_ptr, empty_frame, 0);
+	corrector_ptr->residue = clbrzcrcx8_calculate_crc(crc_configuration_ptr, empty_frame, corrector_ptr->crc_bytes);
+
+	// load factor at most 3/4. there are never more syndromes than 2^width - 1, whatever the pattern count.
+	bit_count = (size_t)max_frame_len * 8;
+	pattern_estimate = (max_errors == 2) ? (bit_count + bit_count * (bit_count - 1) / 2) : bit_count;
+	if((crc_configuration_ptr->width < 32) && (pattern_estimate > (1UL << crc_configuration_ptr->width)))
+	{
+		pattern_estimate = 1UL << crc_configuration_ptr->width;
+	}
+	for (corrector_ptr->slot_bits = 4; ((size_t)1 << corrector_ptr->slot_bits) * 3 / 4 < pattern_estimate; corrector_ptr->slot_bits++)
+	{
+		if(corrector_ptr->slot_bits == 31)
+		{
+			return CLBRZCRCX8_ECC_ERROR_MEMORY;		// double errors in frames of several KiB, far too many patterns.
+		}
+	}
+
+	bit_syndromes = (uint32_t*)malloc(bit_count * sizeof(uint32_t));
+	corrector_ptr->slots = calloc((size_t)1 << corrector_ptr->slot_bits, sizeof(ecc_slot));
+	if( (bit_syndromes == NULL) || (corrector_ptr->slots == NULL) )
+	{
+		free(bit_syndromes);
+		clbrzcrcx8_ecc_free(corrector_ptr);
+		return CLBRZCRCX8_ECC_ERROR_MEMORY;
+	}
+
+	// each pattern is in by its farther bit, so every bit count only adds patterns that need a longer frame.
+	_clbrzcrcx8_ecc_bit_syndromes(crc_configuration_ptr, bit_syndromes, bit_count);
+	for (distance_0 = 0; distance_0 < bit_count; distance_0++)
+	{
+		_clbrzcrcx8_ecc_insert(corrector_ptr, bit_syndromes[distance_0], (uint16_t)distance_0, ECC_NO_DISTANCE);
+		if(max_errors == 2)
+		{
+			for (distance_1 = 0; distance_1 < distance_0; distance_1++)
+			{
+				_clbrzcrcx8_ecc_insert(corrector_ptr, bit_syndromes[distance_0] ^ bit_syndromes[distance_1], (uint16_t)distance_0, (uint16_t)distance_1);
+			}
+		}
+	}
+
+	free(bit_syndromes);
+	return CLBRZCRCX8_ECC_OK;
+}
+
+
+size_t clbrzcrcx8_ecc_append_crc(const CLBRZCRCx8_EccCorrector_t* corrector_ptr, uint8_t* frame, size_t data_len)
+{
+	uint32_t calculated_crc = clbrzcrcx8_calculate_crc(&corrector_ptr->crc_configuration, frame, data_len);
+	uint32_t byte_index;
+
+	// the residue byte order : the CRC goes in the way the register shifts, so running on over it leaves a constant.
+	for (byte_index = 0; byte_index < corrector_ptr->crc_bytes; byte_index++)
+	{
+		frame[data_len + byte_index] = (uint8_t)(corrector_ptr->crc_configuration.reflect_output ?
+													(calculated_crc >> (8 * byte_index)) :
+													(calculated_crc >> (8 * (corrector_ptr->crc_bytes - 1 - byte_index))));
+	}
+
+	return data_len + corrector_ptr->crc_bytes;
+}
+
+
+int clbrzcrcx8_ecc_correct(const CLBRZCRCx8_EccCorrector_t* corrector_ptr, uint8_t* frame, size_t frame_len, size_t* bit_positions)
+{
+	if( (corrector_ptr == NULL) || (corrector_ptr->slots == NULL) || (frame == NULL) ||
+		(frame_len <= corrector_ptr->crc_bytes) || (frame_len > corrector_ptr->max_frame_len) )
+	{
+		return CLBRZCRCX8_ECC_ERROR_ARGUMENT;
+	}
+
+	return _clbrzcrcx8_ecc_repair(corrector_ptr, frame, frame_len,
+									clbrzcrcx8_calculate_crc(&corrector_ptr->crc_configuration, frame, frame_len) ^ corrector_ptr->residue,
+									bit_positions);
+}
+
+
+void clbrzcrcx8_ecc_correct_batch(const CLBRZCRCx8_EccCorrector_t* corrector_ptr,
+									uint8_t* const* frames,
+									const size_t* frame_lengths,
+									int* results,
+									size_t frame_count)
+{
+	const uint8_t* batch_frames[ECC_BATCH_SIZE];
+	size_t batch_lengths[ECC_BATCH_SIZE];
+	size_t batch_indices[ECC_BATCH_SIZE];
+	uint32_t batch_crcs[ECC_BATCH_SIZE];
+	size_t batch_count;
+	size_t frame_index = 0;
+	size_t batch_index;
+
+	while(frame_index < frame_count)
+	{
+		// bad arguments are answered right away, the rest go to the CRC batch.
+		for (batch_count = 0; (batch_count < ECC_BATCH_SIZE) && (frame_index < frame_count); frame_index++)
+		{
+			if( (corrector_ptr == NULL) || (corrector_ptr->slots == NULL) || (frames[frame_index] == NULL) ||
+				(frame_lengths[frame_index] <= corrector_ptr->crc_bytes) || (frame_lengths[frame_index] > corrector_ptr->max_frame_len) )
+			{
+				results[frame_index] = CLBRZCRCX8_ECC_ERROR_ARGUMENT;
+				continue;
+			}
+			batch_frames[batch_count] = frames[frame_index];
+			batch_lengths[batch_count] = frame_lengths[frame_index];
+			batch_indices[batch_count] = frame_index;
+			batch_count++;
+		}
+
+		if(batch_count == 0)
+		{
+			continue;
+		}
+		clbrzcrcx8_calculate_crc_batch(&corrector_ptr->crc_configuration, batch_frames, batch_lengths, batch_crcs, batch_count);
+		for (batch_index = 0; batch_index < batch_count; batch_index++)
+		{
+			results[batch_indices[batch_index]] = _clbrzcrcx8_ecc_repair(corrector_ptr, frames[batch_indices[batch_index]],
+																		batch_lengths[batch_index],
+																		batch_crcs[batch_index] ^ corrector_ptr->residue, NULL);
+		}
+	}
+}
+
+
+void clbrzcrcx8_ecc_free(CLBRZCRCx8_EccCorrector_t* corrector_ptr)
+{
+	free(corrector_ptr->slots);
+	corrector_ptr->slots = NULL;
+	corrector_ptr->pattern_count = 0;
+}
+
+
+
+#ifdef CLBRZCRCX8_ENABLE_ECC_TEST
+
+// random frames of random length, intact / one / two random bits flipped. a frame that correct() changes must come back
+// exactly as sent, with the flipped bits reported : uncorrectable is allowed (ambiguous syndromes), a wrong fix is not.
+// widths of 16 bits and more must fix every single bit error in frames up to ECC_TEST_SINGLE_FRAME_LEN.
+// correct_batch() must give what correct() gives, frame by frame.
+
+#include <stdio.h>
+
+#define ECC_TEST_SINGLE_FRAME_LEN		256
+#define ECC_TEST_DOUBLE_FRAME_LEN		64
+#define ECC_TEST_FRAMES					2000
+#define ECC_TEST_BATCH_FRAMES			300
+
+static uint8_t ecc_test_sent[ECC_TEST_BATCH_FRAMES][ECC_TEST_SINGLE_FRAME_LEN];
+static uint8_t ecc_test_received[ECC_TEST_BATCH_FRAMES][ECC_TEST_SINGLE_FRAME_LEN];
+static uint8_t ecc_test_batch[ECC_TEST_BATCH_FRAMES][ECC_TEST_SINGLE_FRAME_LEN];
+
+
+static uint32_t _clbrzcrcx8_ecc_test_random(uint32_t* random_state)
+{
+	*random_state ^= *random_state << 13;
+	*random_state ^= *random_state >> 17;
+	*random_state ^= *random_state << 5;
+	return *random_state;
+}
+
+
+// a sealed frame in ecc_test_sent[frame_index], received copy with error_count distinct bits flipped, returns its length.
+static size_t _clbrzcrcx8_ecc_test_frame(const CLBRZCRCx8_EccCorrector_t* corrector_ptr, size_t frame_index, int error_count,
+											size_t* flipped, uint32_t* random_state)
+{
+	size_t data_len = 1 + _clbrzcrcx8_ecc_test_random(random_state) % (corrector_ptr->max_frame_len - corrector_ptr->crc_bytes);
+	size_t frame_len;
+	size_t byte_index;
+	int error_index;
+
+	for (byte_index = 0; byte_index < data_len; byte_index++)
+	{
+		ecc_test_sent[frame_index][byte_index] = (uint8_t)_clbrzcrcx8_ecc_test_random(random_state);
+	}
+	frame_len = clbrzcrcx8_ecc_append_crc(corrector_ptr, ecc_test_sent[frame_index], data_len);
+	memcpy(ecc_test_received[frame_index], ecc_test_sent[frame_index], frame_len);
+
+	for (error_index = 0; error_index < error_count; error_index++)
+	{
+		do
+		{
+			flipped[error_index] = _clbrzcrcx8_ecc_test_random(random_state) % (frame_len * 8);
+		} while( (error_index == 1) && (flipped[1] == flipped[0]) );
+		ecc_test_received[frame_index][flipped[error_index] / 8] ^= (uint8_t)(1U << (flipped[error_index] % 8));
+	}
+	if( (error_count == 2) && (flipped[1] < flipped[0]) )
+	{
+		byte_index = flipped[0];
+		flipped[0] = flipped[1];
+		flipped[1] = byte_index;
+	}
+
+	return frame_len;
+}
+
+
+// fixed : frames corrected, out of ECC_TEST_FRAMES with error_count errors. 0 on a wrong fix.
+static int _clbrzcrcx8_ecc_test_errors(const CLBRZCRCx8_EccCorrector_t* corrector_ptr, int error_count, size_t* fixed)
+{
+	uint32_t random_state = 0xecc00000u + (uint32_t)error_count * 977 + corrector_ptr->crc_configuration.width;
+	size_t flipped[2];
+	size_t reported[2];
+	size_t frame_len;
+	int frame_index;
+	int result;
+
+	*fixed = 0;
+	for (frame_index = 0; frame_index < ECC_TEST_FRAMES; frame_index++)
+	{
+		frame_len = _clbrzcrcx8_ecc_test_frame(corrector_ptr, 0, error_count, flipped, &random_state);
+		memcpy(ecc_test_batch[0], ecc_test_received[0], frame_len);
+		result = clbrzcrcx8_ecc_correct(corrector_ptr, ecc_test_received[0], frame_len, reported);
+
+		// not fixed, or not even detected (two bits a multiple of the polynomial apart).
+		if( (result == CLBRZCRCX8_ECC_ERROR_UNCORRECTABLE) || ((result == 0) && (error_count != 0)) )
+		{
+			if(memcmp(ecc_test_received[0], ecc_test_batch[0], frame_len) != 0)		// must be left as it came in
+			{
+				printf("%-16s : %d errors in %u bytes : not fixed, but changed\n", corrector_ptr->crc_configuration.name,
+						error_count, (unsigned int)frame_len);
+				return 0;
+			}
+			continue;
+		}
+		if( (result != error_count) || (memcmp(ecc_test_received[0], ecc_test_sent[0], frame_len) != 0) ||
+			((error_count >= 1) && (reported[0] != flipped[0])) || ((error_count == 2) && (reported[1] != flipped[1])) )
+		{
+			printf("%-16s : %d errors in %u bytes : returned %d\n", corrector_ptr->crc_configuration.name,
+					error_count, (unsigned int)frame_len, result);
+			return 0;
+		}
+		(*fixed)++;
+	}
+
+	return 1; // ok.
+}
+
+
+static int _clbrzcrcx8_ecc_test_batch(const CLBRZCRCx8_EccCorrector_t* corrector_ptr)
+{
+	uint32_t random_state = 0xba7c4u + corrector_ptr->crc_configuration.width;
+	uint8_t* frames[ECC_TEST_BATCH_FRAMES];
+	size_t frame_lengths[ECC_TEST_BATCH_FRAMES];
+	int results[ECC_TEST_BATCH_FRAMES];
+	size_t flipped[2];
+	size_t frame_index;
+
+	for (frame_index = 0; frame_index < ECC_TEST_BATCH_FRAMES; frame_index++)
+	{
+		frame_lengths[frame_index] = _clbrzcrcx8_ecc_test_frame(corrector_ptr, frame_index, (int)(frame_index % (corrector_ptr->max_errors + 1U)),
+																flipped, &random_state);
+		memcpy(ecc_test_batch[frame_index], ecc_test_received[frame_index], frame_lengths[frame_index]);
+		frames[frame_index] = ecc_test_batch[frame_index];
+	}
+	frames[7] = NULL;						// bad frames are answered one by one
+	frame_lengths[11] = corrector_ptr->crc_bytes;
+
+	clbrzcrcx8_ecc_correct_batch(corrector_ptr, frames, frame_lengths, results, ECC_TEST_BATCH_FRAMES);
+
+	for (frame_index = 0; frame_index < ECC_TEST_BATCH_FRAMES; frame_index++)
+	{
+		if( (frames[frame_index] == NULL) ?
+				(results[frame_index] != CLBRZCRCX8_ECC_ERROR_ARGUMENT) :
+				( (results[frame_index] != clbrzcrcx8_ecc_correct(corrector_ptr, ecc_test_received[frame_index], frame_lengths[frame_index], NULL)) ||
+				  (memcmp(ecc_test_batch[frame_index], ecc_test_received[frame_index], frame_lengths[frame_index]) != 0) ) )
+		{
+			printf("%-16s : batch frame %u : %d\n", corrector_ptr->crc_configuration.name, (unsigned int)frame_index, results[frame_index]);
+			return 0;
+		}
+	}
+
+	return 1; // ok.
+}
+
+
+int main()
+{
+	CLBRZCRCx8_CRCTypeDescriptor_t bad_configuration = clbrzcrcx8_crc_algo_list[0];
+	CLBRZCRCx8_EccCorrector_t corrector;
+	size_t single_fixed;
+	size_t double_fixed = 0;
+	int algo_index;
+	int passed;
+	int failed = 0;
+
+	bad_configuration.reflect_input = !bad_configuration.reflect_output;
+	if( (clbrzcrcx8_ecc_init(&corrector, &bad_configuration, 64, 1) != CLBRZCRCX8_ECC_ERROR_ARGUMENT) ||
+		(clbrzcrcx8_ecc_init(&corrector, &clbrzcrcx8_crc_algo_list[0], 1, 1) != CLBRZCRCX8_ECC_ERROR_ARGUMENT) ||
+		(clbrzcrcx8_ecc_init(&corrector, &clbrzcrcx8_crc_algo_list[0], CLBRZCRCX8_ECC_MAX_FRAME_LEN + 1, 1) != CLBRZCRCX8_ECC_ERROR_ARGUMENT) ||
+		(clbrzcrcx8_ecc_init(&corrector, &clbrzcrcx8_crc_algo_list[0], 64, 3) != CLBRZCRCX8_ECC_ERROR_ARGUMENT) ||
+		(clbrzcrcx8_ecc_init(&corrector, &clbrzcrcx8_crc_algo_list[0], 64, 1) != CLBRZCRCX8_ECC_OK) ||
+		(clbrzcrcx8_ecc_correct(&corrector, ecc_test_received[0], 65, NULL) != CLBRZCRCX8_ECC_ERROR_ARGUMENT) ||
+		(clbrzcrcx8_ecc_correct(&corrector, ecc_test_received[0], 1, NULL) != CLBRZCRCX8_ECC_ERROR_ARGUMENT) )
+	{
+		printf("argument checks : FAIL\n");
+		failed++;
+	}
+	clbrzcrcx8_ecc_free(&corrector);
+
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		passed = (clbrzcrcx8_ecc_init(&corrector, &clbrzcrcx8_crc_algo_list[algo_index], ECC_TEST_SINGLE_FRAME_LEN, 1) == CLBRZCRCX8_ECC_OK) &&
+					_clbrzcrcx8_ecc_test_errors(&corrector, 0, &single_fixed) &&
+					_clbrzcrcx8_ecc_test_errors(&corrector, 1, &single_fixed) &&
+					((clbrzcrcx8_crc_algo_list[algo_index].width < 16) || (single_fixed == ECC_TEST_FRAMES)) &&
+					_clbrzcrcx8_ecc_test_batch(&corrector);
+		clbrzcrcx8_ecc_free(&corrector);
+
+		passed = passed &&
+					(clbrzcrcx8_ecc_init(&corrector, &clbrzcrcx8_crc_algo_list[algo_index], ECC_TEST_DOUBLE_FRAME_LEN, 2) == CLBRZCRCX8_ECC_OK) &&
+					_clbrzcrcx8_ecc_test_errors(&corrector, 1, &double_fixed) &&
+					_clbrzcrcx8_ecc_test_errors(&corrector, 2, &double_fixed) &&
+					_clbrzcrcx8_ecc_test_batch(&corrector);
+		clbrzcrcx8_ecc_free(&corrector);
+
+		printf("%-16s : single fixed %5.1f %% (%u bytes), double fixed %5.1f %% (%u bytes) : %s\n", clbrzcrcx8_crc_algo_list[algo_index].name,
+				100.0 * single_fixed / ECC_TEST_FRAMES, ECC_TEST_SINGLE_FRAME_LEN,
+				100.0 * double_fixed / ECC_TEST_FRAMES, ECC_TEST_DOUBLE_FRAME_LEN, passed ? "PASS" : "FAIL");
+		failed += !passed;
+	}
+
+	return (failed == 0) ? 0 : 1;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_ECC_TEST
@@ -0,0 +1,130 @@
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+    This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+
+
+	Description : error correction, fix single (and double) bit errors in a frame from its CRC syndrome, on top of clbrz_crcx8.
+				 a frame is the data followed by its CRC, (width / 8) bytes, in the byte order that gives the descriptor's
+				 residue (little endian for reflected algorithms, big endian otherwise) : CRC (frame) = residue when intact.
+
+				 CRCs are linear : CRC (frame ^ error) ^ residue depends only on the error, not on the data, and for a
+				 single flipped bit only on how far it is from the end of the frame. so one table, syndrome -> bit
+				 distance(s), built once per descriptor and max frame length, serves every frame up to that length.
+				 the table is a hash map, a failing frame costs one CRC and one lookup.
+
+				 a syndrome shared by two error patterns is only used for frames too short for the other pattern,
+				 anything still ambiguous is reported as uncorrectable, never guessed.
+				 more errors than max_errors can be miscorrected : the CRC then no longer proves the frame good.
+				 memory : 12 byte slots, at most 3/4 used, for 8 * L patterns (single) or (8 * L)^2 / 2 (double) in L byte
+				 frames, and never more than 2^width (CRC-24/BLE, 260 byte frames, double : 48 MiB, CRC-16 : 1.5 MiB).
+
+	usage :
+	(1) init() with a descriptor, the max frame length (data + CRC) in bytes and max_errors, 1 or 2.
+	(2) append_crc() to build a frame, correct() / correct_batch() on received frames.
+	(3) free() once done, the corrector is read only after init() and can be used from any number of threads.
+
+ ============================================================================
+ */
+
+#ifndef CLBRZ_CRCX8_ECC_H_
+#define CLBRZ_CRCX8_ECC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "clbrz_crcx8.h"
+
+
+//#define CLBRZCRCX8_ENABLE_ECC_TEST			// enable to build the error correction test main()
+
+// bit distances are kept in 16 bits.
+#define CLBRZCRCX8_ECC_MAX_FRAME_LEN			8191
+
+// return values : correct() returns the number of bits it fixed (0 : the frame was good), errors are negative.
+#define CLBRZCRCX8_ECC_OK						0
+#define CLBRZCRCX8_ECC_ERROR_ARGUMENT			(-1)	// bad parameter, frame shorter than the CRC or longer than max_frame_len
+#define CLBRZCRCX8_ECC_ERROR_MEMORY				(-2)
+#define CLBRZCRCX8_ECC_ERROR_UNCORRECTABLE		(-3)	// more errors than max_errors, or an ambiguous syndrome
+
+
+typedef struct _crcEccCorrector
+{
+	CLBRZCRCx8_CRCTypeDescriptor_t crc_configuration;
+	uint32_t	residue;				// CRC of any intact frame
+	uint32_t	crc_bytes;				// CRC bytes at the end of each frame
+	uint32_t	max_frame_len;
+	uint8_t		max_errors;
+	uint8_t		slot_bits;				// the hash map has 2^slot_bits slots
+	void*		slots;					// the hash map, syndrome -> bit distance(s) from the frame end
+	size_t		pattern_count;			// syndromes in the hash map, each for one or more error patterns
+
+} CLBRZCRCx8_EccCorrector_t;
+
+
+// build the syndrome table, crc_configuration_ptr is copied. width a multiple of 8, reflect_input == reflect_output.
+int clbrzcrcx8_ecc_init(CLBRZCRCx8_EccCorrector_t* corrector_ptr,
+						const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+						uint32_t max_frame_len,
+						uint8_t max_errors);
+
+// write the CRC of frame[0 .. data_len) after it, returns the frame length (data_len + crc_bytes).
+size_t clbrzcrcx8_ecc_append_crc(const CLBRZCRCx8_EccCorrector_t* corrector_ptr, uint8_t* frame, size_t data_len);
+
+// check the frame and fix it in place. returns the number of bits fixed, 0 if it was good, or an error.
+// bit_positions (if not NULL, room for max_errors) : the bits fixed in frame order, byte index * 8 + bit (0 : LSB).
+int clbrzcrcx8_ecc_correct(const CLBRZCRCx8_EccCorrector_t* corrector_ptr, uint8_t* frame, size_t frame_len, size_t* bit_positions);
+
+// correct() for frame_count frames, results[n] as correct() returns it for frames[n].
+// the syndromes are calculated side by side (calculate_crc_batch()), only the failing frames take a lookup.
+void clbrzcrcx8_ecc_correct_batch(const CLBRZCRCx8_EccCorrector_t* corrector_ptr,
+									uint8_t* const* frames,
+									const size_t* frame_lengths,
+									int* results,
+									size_t frame_count);
+
+void clbrzcrcx8_ecc_free(CLBRZCRCx8_EccCorrector_t* corrector_ptr);
+
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif /* CLBRZ_CRCX8_ECC_H_ */
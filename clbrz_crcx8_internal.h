@@ -0,0 +1,83 @@
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+    This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+
+
+	Description : internal to the library sources, not installed.
+				 what the binary formats of the library (checkpoints, block store index and trailer, calibration files)
+				 share, so they cannot drift apart : the CRC-32C that protects their metadata and the little endian fields.
+
+ ============================================================================
+ */
+
+#ifndef CLBRZ_CRCX8_INTERNAL_H_
+#define CLBRZ_CRCX8_INTERNAL_H_
+
+#include <stdint.h>
+
+#include "clbrz_crcx8.h"
+
+
+// metadata of every binary format is protected by CRC-32C, whatever algorithm the data itself uses. defined in clbrz_crcx8.c.
+extern const CLBRZCRCx8_CRCTypeDescriptor_t _clbrzcrcx8_metadata_crc;
+
+
+static inline void _clbrzcrcx8_put_le(uint8_t* byte_data, uint64_t value, int byte_count)
+{
+	int byte_index;
+
+	for (byte_index = 0; byte_index < byte_count; byte_index++)
+	{
+		byte_data[byte_index] = (uint8_t)(value >> (8 * byte_index));
+	}
+}
+
+
+static inline uint64_t _clbrzcrcx8_get_le(const uint8_t* byte_data, int byte_count)
+{
+	uint64_t value = 0;
+	int byte_index;
+
+	for (byte_index = byte_count - 1; byte_index >= 0; byte_index--)
+	{
+		value = (value << 8) | byte_data[byte_index];
+	}
+
+	return value;
+}
+
+#endif /* CLBRZ_CRCX8_INTERNAL_H_ */
@@ -0,0 +1,434 @@
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+    This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+
+
+
+	Description : chunk pipeline, a double/ring buffered crc of a peripheral stream, see clbrz_crcx8_pipeline.h
+
+ ============================================================================
+ */
+
+// the test's simulated producer is a pthread, the pipeline itself needs nothing but C.
+#if defined(CLBRZCRCX8_ENABLE_PIPELINE_TEST) && !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "clbrz_crcx8_pipeline.h"
+
+#include <string.h>
+
+
+// the producer publishes a chunk (length, then committed) with a release store, the consumer frees a buffer the same way,
+// each side reads the other's counter with an acquire load.
+#if defined(__GNUC__)
+#define PIPELINE_COUNTER_LOAD(counter)				__atomic_load_n(&(counter), __ATOMIC_ACQUIRE)
+#define PIPELINE_COUNTER_PUBLISH(counter, value)	__atomic_store_n(&(counter), (value), __ATOMIC_RELEASE)
+#else
+// other compilers : volatile only, enough between an interrupt and the main loop on a single core.
+#define PIPELINE_COUNTER_LOAD(counter)				(counter)
+#define PIPELINE_COUNTER_PUBLISH(counter, value)	((counter) = (value))
+#endif // #if defined(__GNUC__)
+
+
+// the counters run modulo 2 * buffer_count, not free : a uint32_t wrap would break "counter % buffer_count" for
+// counts that are not a power of two. twice the count still tells a full ring (distance buffer_count) from an empty one.
+static uint32_t _clbrzcrcx8_pipeline_distance(const CLBRZCRCx8_Pipeline_t* pipeline_ptr, uint32_t later, uint32_t earlier)
+{
+	return (later >= earlier) ? (later - earlier) : (later + 2 * pipeline_ptr->buffer_count - earlier);
+}
+
+
+static uint32_t _clbrzcrcx8_pipeline_next(const CLBRZCRCx8_Pipeline_t* pipeline_ptr, uint32_t counter)
+{
+	return (counter + 1 == 2 * pipeline_ptr->buffer_count) ? 0 : (counter + 1);
+}
+
+
+static uint32_t _clbrzcrcx8_pipeline_slot(const CLBRZCRCx8_Pipeline_t* pipeline_ptr, uint32_t counter)
+{
+	return (counter >= pipeline_ptr->buffer_count) ? (counter - pipeline_ptr->buffer_count) : counter;
+}
+
+
+int clbrzcrcx8_pipeline_init(CLBRZCRCx8_Pipeline_t* pipeline_ptr,
+								const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+								uint8_t* storage,
+								uint32_t buffer_count,
+								size_t buffer_size,
+								const CLBRZCRCx8_PipelineCallbacks_t* callbacks_ptr,
+								void* user_data)
+{
+	if( (pipeline_ptr == NULL) || (crc_configuration_ptr == NULL) || (storage == NULL) || (buffer_size == 0) ||
+		(buffer_count == 0) || (buffer_count > CLBRZCRCX8_PIPELINE_MAX_BUFFERS) )
+	{
+		return CLBRZCRCX8_PIPELINE_ERROR_ARGUMENT;
+	}
+
+	memset(pipeline_ptr, 0, sizeof(*pipeline_ptr));
+	clbrzcrcx8_init_crc_state(&pipeline_ptr->crc_state, crc_configuration_ptr);
+	if(callbacks_ptr != NULL)
+	{
+		pipeline_ptr->callbacks = *callbacks_ptr;
+	}
+	pipeline_ptr->user_data = user_data;
+	pipeline_ptr->storage = storage;
+	pipeline_ptr->buffer_count = buffer_count;
+	pipeline_ptr->buffer_size = buffer_size;
+
+	return CLBRZCRCX8_PIPELINE_OK;
+}
+
+
+uint8_t* clbrzcrcx8_pipeline_producer_buffer(CLBRZCRCx8_Pipeline_t* pipeline_ptr)
+{
+	uint32_t committed = pipeline_ptr->committed;	// own counter, no ordering needed
+
+	if( (pipeline_ptr->end_of_stream != 0) ||
+		(_clbrzcrcx8_pipeline_distance(pipeline_ptr, committed, PIPELINE_COUNTER_LOAD(pipeline_ptr->consumed)) >= pipeline_ptr->buffer_count) )
+	{
+		return NULL;
+	}
+
+	return pipeline_ptr->storage + (size_t)_clbrzcrcx8_pipeline_slot(pipeline_ptr, committed) * pipeline_ptr->buffer_size;
+}
+
+
+int clbrzcrcx8_pipeline_producer_commit(CLBRZCRCx8_Pipeline_t* pipeline_ptr, size_t chunk_len, uint8_t end_of_stream)
+{
+	uint32_t committed = pipeline_ptr->committed;
+
+	if(chunk_len > pipeline_ptr->buffer_size)
+	{
+		return CLBRZCRCX8_PIPELINE_ERROR_ARGUMENT;
+	}
+	if(clbrzcrcx8_pipeline_producer_buffer(pipeline_ptr) == NULL)
+	{
+		return CLBRZCRCX8_PIPELINE_ERROR_FULL;
+	}
+
+	// the slot is owned by the producer until the publish below, the consumer never reads it earlier.
+	pipeline_ptr->chunk_lengths[_clbrzcrcx8_pipeline_slot(pipeline_ptr, committed)] = chunk_len;
+	pipeline_ptr->chunk_end_of_stream[_clbrzcrcx8_pipeline_slot(pipeline_ptr, committed)] = (end_of_stream != 0);
+	pipeline_ptr->end_of_stream = (end_of_stream != 0);
+	PIPELINE_COUNTER_PUBLISH(pipeline_ptr->committed, _clbrzcrcx8_pipeline_next(pipeline_ptr, committed));
+
+	return CLBRZCRCX8_PIPELINE_OK;
+}
+
+
+size_t clbrzcrcx8_pipeline_consume(CLBRZCRCx8_Pipeline_t* pipeline_ptr)
+{
+	uint32_t consumed = pipeline_ptr->consumed;		// own counter, no ordering needed
+	uint32_t committed = PIPELINE_COUNTER_LOAD(pipeline_ptr->committed);
+	size_t chunk_count = 0;
+	const uint8_t* chunk;
+	size_t chunk_len;
+	uint32_t intermediate_crc;
+	int end_of_stream;
+
+	for (; consumed != committed; chunk_count++)
+	{
+		chunk = pipeline_ptr->storage + (size_t)_clbrzcrcx8_pipeline_slot(pipeline_ptr, consumed) * pipeline_ptr->buffer_size;
+		chunk_len = pipeline_ptr->chunk_lengths[_clbrzcrcx8_pipeline_slot(pipeline_ptr, consumed)];
+		end_of_stream = pipeline_ptr->chunk_end_of_stream[_clbrzcrcx8_pipeline_slot(pipeline_ptr, consumed)];
+
+		intermediate_crc = clbrzcrcx8_update_crc_state(&pipeline_ptr->crc_state, chunk, chunk_len);
+		if(pipeline_ptr->callbacks.chunk_done != NULL)
+		{
+			pipeline_ptr->callbacks.chunk_done(pipeline_ptr->user_data, chunk, chunk_len, intermediate_crc);
+		}
+
+		// the buffer goes back before anything else is called, the producer may be waiting for it.
+		consumed = _clbrzcrcx8_pipeline_next(pipeline_ptr, consumed);
+		PIPELINE_COUNTER_PUBLISH(pipeline_ptr->consumed, consumed);
+		if(pipeline_ptr->callbacks.buffer_free != NULL)
+		{
+			pipeline_ptr->callbacks.buffer_free(pipeline_ptr->user_data);
+		}
+
+		if(end_of_stream)
+		{
+			pipeline_ptr->crc = clbrzcrcx8_finalize_crc_state(&pipeline_ptr->crc_state);
+			pipeline_ptr->finished = 1;
+			if(pipeline_ptr->callbacks.stream_done != NULL)
+			{
+				pipeline_ptr->callbacks.stream_done(pipeline_ptr->user_data, pipeline_ptr->crc);
+			}
+			chunk_count++;
+			break;
+		}
+
+		// chunks committed meanwhile are taken in the same call.
+		if(consumed == committed)
+		{
+			committed = PIPELINE_COUNTER_LOAD(pipeline_ptr->committed);
+		}
+	}
+
+	return chunk_count;
+}
+
+
+int clbrzcrcx8_pipeline_finished(const CLBRZCRCx8_Pipeline_t* pipeline_ptr)
+{
+	return pipeline_ptr->finished;
+}
+
+
+void clbrzcrcx8_pipeline_reset(CLBRZCRCx8_Pipeline_t* pipeline_ptr)
+{
+	clbrzcrcx8_reset_crc_state(&pipeline_ptr->crc_state);
+	pipeline_ptr->end_of_stream = 0;
+	pipeline_ptr->committed = 0;
+	pipeline_ptr->consumed = 0;
+	pipeline_ptr->finished = 0;
+	pipeline_ptr->crc = 0;
+}
+
+
+
+#ifdef CLBRZCRCX8_ENABLE_PIPELINE_TEST
+
+// a simulated peripheral : a producer thread streams a known pseudo-random sequence in random sized chunks, with random
+// "transfer" delays, the main thread is the consumer, with its own random delays, so both sides get to wait for each other.
+// the crc must match the one shot crc of the same sequence, for every buffer count.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+#define PIPELINE_TEST_STREAM_SIZE		(256 * 1024 + 77)
+#define PIPELINE_TEST_BUFFER_SIZE		1024
+
+static uint8_t pipeline_test_stream[PIPELINE_TEST_STREAM_SIZE];
+static uint8_t pipeline_test_storage[CLBRZCRCX8_PIPELINE_STORAGE_SIZE(CLBRZCRCX8_PIPELINE_MAX_BUFFERS, PIPELINE_TEST_BUFFER_SIZE)];
+
+struct pipeline_test
+{
+	CLBRZCRCx8_Pipeline_t pipeline;
+	uint32_t random_state;			// producer only
+	size_t consumed_bytes;			// consumer only, from chunk_done
+	size_t buffers_freed;
+	int stream_done_calls;
+	int chunk_mismatch;
+};
+
+
+static uint32_t _clbrzcrcx8_pipeline_test_random(uint32_t* random_state)
+{
+	*random_state ^= *random_state << 13;
+	*random_state ^= *random_state >> 17;
+	*random_state ^= *random_state << 5;
+	return *random_state;
+}
+
+
+static void _clbrzcrcx8_pipeline_test_delay(uint32_t* random_state)
+{
+	struct timespec delay = { 0, 0 };
+
+	// mostly none, now and then a few microseconds.
+	if((_clbrzcrcx8_pipeline_test_random(random_state) & 7) == 0)
+	{
+		delay.tv_nsec = (long)(_clbrzcrcx8_pipeline_test_random(random_state) % 20000);
+		nanosleep(&delay, NULL);
+	}
+}
+
+
+static void* _clbrzcrcx8_pipeline_test_producer(void* test_arg)
+{
+	struct pipeline_test* test = (struct pipeline_test*)test_arg;
+	struct timespec wait = { 0, 1000 };
+	size_t stream_offset = 0;
+	size_t chunk_len;
+	uint8_t* buffer;
+
+	while(stream_offset < PIPELINE_TEST_STREAM_SIZE)
+	{
+		buffer = clbrzcrcx8_pipeline_producer_buffer(&test->pipeline);
+		if(buffer == NULL)
+		{
+			// a real driver would re-arm the transfer from buffer_free(), the simulation just waits.
+			nanosleep(&wait, NULL);
+			continue;
+		}
+
+		// random lengths, empty chunks included, like a peripheral with variable sized frames.
+		chunk_len = _clbrzcrcx8_pipeline_test_random(&test->random_state) % (PIPELINE_TEST_BUFFER_SIZE + 1);
+		chunk_len = (chunk_len < PIPELINE_TEST_STREAM_SIZE - stream_offset) ? chunk_len : (PIPELINE_TEST_STREAM_SIZE - stream_offset);
+		_clbrzcrcx8_pipeline_test_delay(&test->random_state);
+		memcpy(buffer, &pipeline_test_stream[stream_offset], chunk_len);
+		stream_offset += chunk_len;
+
+		clbrzcrcx8_pipeline_producer_commit(&test->pipeline, chunk_len, (uint8_t)(stream_offset == PIPELINE_TEST_STREAM_SIZE));
+	}
+
+	return NULL;
+}
+
+
+static void _clbrzcrcx8_pipeline_test_chunk_done(void* user_data, const uint8_t* chunk, size_t chunk_len, uint32_t intermediate_crc)
+{
+	struct pipeline_test* test = (struct pipeline_test*)user_data;
+
+	(void)intermediate_crc;
+	if(memcmp(chunk, &pipeline_test_stream[test->consumed_bytes], chunk_len) != 0)
+	{
+		test->chunk_mismatch++;
+	}
+	test->consumed_bytes += chunk_len;
+}
+
+
+static void _clbrzcrcx8_pipeline_test_buffer_free(void* user_data)
+{
+	((struct pipeline_test*)user_data)->buffers_freed++;
+}
+
+
+static void _clbrzcrcx8_pipeline_test_stream_done(void* user_data, uint32_t crc)
+{
+	(void)crc;
+	((struct pipeline_test*)user_data)->stream_done_calls++;
+}
+
+
+static int _clbrzcrcx8_pipeline_test(const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr, uint32_t buffer_count)
+{
+	static const CLBRZCRCx8_PipelineCallbacks_t callbacks =
+	{
+		_clbrzcrcx8_pipeline_test_chunk_done,
+		_clbrzcrcx8_pipeline_test_buffer_free,
+		_clbrzcrcx8_pipeline_test_stream_done
+	};
+	struct pipeline_test test;
+	pthread_t producer;
+	uint32_t consumer_random_state = 0xc0ffee ^ buffer_count;
+	uint32_t expected_crc = clbrzcrcx8_calculate_crc(crc_configuration_ptr, pipeline_test_stream, PIPELINE_TEST_STREAM_SIZE);
+	size_t chunk_count = 0;
+	int stream_index;
+
+	memset(&test, 0, sizeof(test));
+	test.random_state = 0x5eed0000u + buffer_count;
+	if(clbrzcrcx8_pipeline_init(&test.pipeline, crc_configuration_ptr, pipeline_test_storage, buffer_count,
+								PIPELINE_TEST_BUFFER_SIZE, &callbacks, &test) != CLBRZCRCX8_PIPELINE_OK)
+	{
+		return 0;
+	}
+
+	// two streams through the same pipeline, the second after a reset.
+	for (stream_index = 0; stream_index < 2; stream_index++)
+	{
+		if(pthread_create(&producer, NULL, _clbrzcrcx8_pipeline_test_producer, &test) != 0)
+		{
+			return 0;
+		}
+		while(!clbrzcrcx8_pipeline_finished(&test.pipeline))
+		{
+			chunk_count += clbrzcrcx8_pipeline_consume(&test.pipeline);
+			_clbrzcrcx8_pipeline_test_delay(&consumer_random_state);
+		}
+		pthread_join(producer, NULL);
+
+		if( (test.pipeline.crc != expected_crc) || (test.consumed_bytes != PIPELINE_TEST_STREAM_SIZE) || (test.chunk_mismatch != 0) ||
+			(test.stream_done_calls != 1) || (test.buffers_freed != chunk_count) ||
+			(clbrzcrcx8_pipeline_producer_buffer(&test.pipeline) != NULL) ||
+			(clbrzcrcx8_pipeline_producer_commit(&test.pipeline, 1, 1) != CLBRZCRCX8_PIPELINE_ERROR_FULL) )
+		{
+			printf("%-16s : %u buffers : crc 0x%08x expected 0x%08x, %u bytes, %d bad chunks\n",
+					crc_configuration_ptr->name, (unsigned int)buffer_count, (unsigned int)test.pipeline.crc,
+					(unsigned int)expected_crc, (unsigned int)test.consumed_bytes, test.chunk_mismatch);
+			return 0;
+		}
+
+		clbrzcrcx8_pipeline_reset(&test.pipeline);
+		test.consumed_bytes = 0;
+		test.buffers_freed = 0;
+		test.stream_done_calls = 0;
+		chunk_count = 0;
+	}
+
+	return 1; // ok.
+}
+
+
+int main()
+{
+	static const uint32_t buffer_counts[] = { 1, 2, 3, CLBRZCRCX8_PIPELINE_MAX_BUFFERS };
+	uint8_t bad_storage[4];
+	CLBRZCRCx8_Pipeline_t pipeline;
+	size_t data_index;
+	size_t count_index;
+	int algo_index;
+	int failed = 0;
+
+	srand(0x91be);
+	for (data_index = 0; data_index < PIPELINE_TEST_STREAM_SIZE; data_index++)
+	{
+		pipeline_test_stream[data_index] = (uint8_t)rand();
+	}
+
+	if( (clbrzcrcx8_pipeline_init(&pipeline, &clbrzcrcx8_crc_algo_list[0], bad_storage, 0, 4, NULL, NULL) != CLBRZCRCX8_PIPELINE_ERROR_ARGUMENT) ||
+		(clbrzcrcx8_pipeline_init(&pipeline, &clbrzcrcx8_crc_algo_list[0], bad_storage, CLBRZCRCX8_PIPELINE_MAX_BUFFERS + 1, 4, NULL, NULL)
+				!= CLBRZCRCX8_PIPELINE_ERROR_ARGUMENT) ||
+		(clbrzcrcx8_pipeline_init(&pipeline, &clbrzcrcx8_crc_algo_list[0], bad_storage, 1, 4, NULL, NULL) != CLBRZCRCX8_PIPELINE_OK) ||
+		(clbrzcrcx8_pipeline_producer_commit(&pipeline, 5, 0) != CLBRZCRCX8_PIPELINE_ERROR_ARGUMENT) )
+	{
+		printf("argument checks : FAIL\n");
+		failed++;
+	}
+
+	for (algo_index = 0; algo_index < clbrzcrcx8_crc_algo_list_size; algo_index++)
+	{
+		for (count_index = 0; count_index < sizeof(buffer_counts) / sizeof(buffer_counts[0]); count_index++)
+		{
+			if(_clbrzcrcx8_pipeline_test(&clbrzcrcx8_crc_algo_list[algo_index], buffer_counts[count_index]) != 1)
+			{
+				failed++;
+				break;
+			}
+		}
+		printf("%-16s : %s\n", clbrzcrcx8_crc_algo_list[algo_index].name, (count_index == sizeof(buffer_counts) / sizeof(buffer_counts[0])) ? "PASS" : "FAIL");
+	}
+
+	return (failed == 0) ? 0 : 1;
+}
+
+#endif // #ifdef CLBRZCRCX8_ENABLE_PIPELINE_TEST
@@ -0,0 +1,150 @@
+/*
+ ============================================================================
+
+ ██████╗██████╗  ██████╗██╗  ██╗ █████╗
+██╔════╝██╔══██╗██╔════╝╚██╗██╔╝██╔══██╗
+██║     ██████╔╝██║      ╚███╔╝ ╚█████╔╝
+██║     ██╔══██╗██║      ██╔██╗ ██╔══██╗
+╚██████╗██║  ██║╚██████╗██╔╝ ██╗╚█████╔╝
+ ╚═════╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝ ╚════╝
+
+	Author      : clbrz
+	Version     : v1.3
+
+    This is free and unencumbered software released into the public domain.
+
+    Anyone is free to copy, modify, publish, use, compile, sell, or
+    distribute this software, either in source code form or as a compiled
+    binary, for any purpose, commercial or non-commercial, and by any
+    means.
+
+    In jurisdictions that recognize copyright laws, the author or authors
+    of this software dedicate any and all copyright interest in the
+    software to the public domain. We make this dedication for the benefit
+    of the public at large and to the detriment of our heirs and
+    successors. We intend this dedication to be an overt act of
+    relinquishment in perpetuity of all present and future rights to this
+    software under copyright law.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+    OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+    ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+
+    For more information, please refer to <http://unlicense.org/>
+
+
+	Description : chunk pipeline, a double/ring buffered crc of a peripheral stream, on top of clbrz_crcx8.
+				 the producer (a DMA complete interrupt, a driver thread) fills one buffer while the crc runs over the one
+				 filled before it : the cpu no longer waits for the next chunk, the peripheral no longer waits for the crc.
+				 2 buffers = double buffering, more = a ring, which absorbs jitter on either side.
+
+				 no dynamic allocation : the caller gives the buffer memory (static, CLBRZCRCX8_PIPELINE_STORAGE_SIZE()),
+				 the pipeline itself is a fixed size struct, so the whole memory budget is known at build time.
+				 one producer, one consumer : the only shared state is two counters, each written by one side only,
+				 so it works between an interrupt and the main loop, or between two threads.
+
+	usage :
+	(1) init() with a descriptor, the buffer memory and the callbacks (any of them can be NULL).
+	(2) producer : producer_buffer() gives the buffer to fill next, NULL if all are full (the crc is behind),
+		producer_commit() hands it over when it is filled, end_of_stream set on the last one.
+	(3) consumer (main loop, crc thread) : consume() runs the crc over the filled buffers and gives them back,
+		calling chunk_done() after each buffer, buffer_free() once it is free again (to restart a producer that ran out),
+		and stream_done() with the final crc.
+	(4) reset() before the next stream.
+
+ ============================================================================
+ */
+
+#ifndef CLBRZ_CRCX8_PIPELINE_H_
+#define CLBRZ_CRCX8_PIPELINE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "clbrz_crcx8.h"
+
+
+//#define CLBRZCRCX8_ENABLE_PIPELINE_TEST		// enable to build the pipeline test main() (simulated producer thread, needs pthreads)
+
+#ifndef CLBRZCRCX8_PIPELINE_MAX_BUFFERS
+#define CLBRZCRCX8_PIPELINE_MAX_BUFFERS			8
+#endif // #ifndef CLBRZCRCX8_PIPELINE_MAX_BUFFERS
+
+// bytes of buffer memory to give init(), e.g. static uint8_t storage[CLBRZCRCX8_PIPELINE_STORAGE_SIZE(2, 512)];
+#define CLBRZCRCX8_PIPELINE_STORAGE_SIZE(buffer_count, buffer_size)		((buffer_count) * (buffer_size))
+
+// return values : 0 is ok, everything else is an error.
+#define CLBRZCRCX8_PIPELINE_OK					0
+#define CLBRZCRCX8_PIPELINE_ERROR_ARGUMENT		(-1)	// bad parameter, or a chunk longer than a buffer
+#define CLBRZCRCX8_PIPELINE_ERROR_FULL			(-2)	// commit without a free buffer, or after the end of the stream
+
+
+typedef struct _crcPipelineCallbacks
+{
+	// consumer side, after the crc of a chunk, the chunk is still valid. intermediate_crc as update_crc_state() returns it.
+	void		(*chunk_done)(void* user_data, const uint8_t* chunk, size_t chunk_len, uint32_t intermediate_crc);
+	// consumer side, a buffer went back to the producer.
+	void		(*buffer_free)(void* user_data);
+	// consumer side, the end_of_stream chunk is done.
+	void		(*stream_done)(void* user_data, uint32_t crc);
+
+} CLBRZCRCx8_PipelineCallbacks_t;
+
+
+typedef struct _crcPipeline
+{
+	CLBRZCRCx8_CRCState_t crc_state;
+	CLBRZCRCx8_PipelineCallbacks_t callbacks;
+	void*		user_data;
+	uint8_t*	storage;
+	size_t		buffer_size;
+	uint32_t	buffer_count;
+	size_t		chunk_lengths[CLBRZCRCX8_PIPELINE_MAX_BUFFERS];		// written by the producer before it commits
+	uint8_t		chunk_end_of_stream[CLBRZCRCX8_PIPELINE_MAX_BUFFERS];	// likewise, 1 : last chunk of the stream
+	uint8_t		end_of_stream;			// producer side only, no commits until reset
+	volatile uint32_t committed;		// chunks handed over so far, modulo 2 * buffer_count, written by the producer only
+	volatile uint32_t consumed;			// chunks done so far, modulo 2 * buffer_count, written by the consumer only
+	uint8_t		finished;				// consumer side : stream_done() was called
+	uint32_t	crc;					// the final crc, once finished
+
+} CLBRZCRCx8_Pipeline_t;
+
+
+// storage : buffer_count * buffer_size bytes, buffer_count in [1, CLBRZCRCX8_PIPELINE_MAX_BUFFERS], crc_configuration_ptr is copied.
+int clbrzcrcx8_pipeline_init(CLBRZCRCx8_Pipeline_t* pipeline_ptr,
+								const CLBRZCRCx8_CRCTypeDescriptor_t* crc_configuration_ptr,
+								uint8_t* storage,
+								uint32_t buffer_count,
+								size_t buffer_size,
+								const CLBRZCRCx8_PipelineCallbacks_t* callbacks_ptr,
+								void* user_data);
+
+// producer side : the buffer to fill next (buffer_size bytes), NULL if none is free or the stream has ended.
+uint8_t* clbrzcrcx8_pipeline_producer_buffer(CLBRZCRCx8_Pipeline_t* pipeline_ptr);
+
+// producer side : the buffer from producer_buffer() holds chunk_len bytes now, end_of_stream = 1 on the last chunk.
+int clbrzcrcx8_pipeline_producer_commit(CLBRZCRCx8_Pipeline_t* pipeline_ptr, size_t chunk_len, uint8_t end_of_stream);
+
+// consumer side : crc over every committed chunk, returns how many. never blocks.
+size_t clbrzcrcx8_pipeline_consume(CLBRZCRCx8_Pipeline_t* pipeline_ptr);
+
+// consumer side : 1 once the end_of_stream chunk is done, the crc is in pipeline_ptr->crc.
+int clbrzcrcx8_pipeline_finished(const CLBRZCRCx8_Pipeline_t* pipeline_ptr);
+
+// same descriptor, buffers and callbacks, new stream. only while the producer is idle.
+void clbrzcrcx8_pipeline_reset(CLBRZCRCx8_Pipeline_t* pipeline_ptr);
+
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif /* CLBRZ_CRCX8_PIPELINE_H_ */